@@ -0,0 +1,86 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "common.h"
+#include <vector>
+
+/**
+ * ============================================================================
+ * 바이트 arena (bump-pointer 할당)
+ * ============================================================================
+ *
+ * 청크 단위로 메모리를 잡아 앞에서부터 잘라 주기만 하고, 개별 해제는 없다.
+ * 해시 테이블 구축처럼 같이 생기고 같이 버려지는 레코드 바이트를 담는다.
+ *
+ * - 청크를 새로 잡아도 기존 바이트를 옮기지 않으므로 (vector 재할당 복사 없음)
+ *   allocate()가 돌려준 주소는 rewind()/release() 전까지 유지된다.
+ * - 청크 크기는 MIN_CHUNK부터 두 배씩 MAX_CHUNK까지 자라므로, 잡아 둔 메모리는
+ *   사용량 + 청크 하나를 넘지 않는다. 크기를 알면 reserve()로 한 청크에 담는다.
+ * - rewind()는 청크를 그대로 두고 처음부터 다시 채우고 (재사용),
+ *   release()는 모든 청크를 한 번에 해제한다.
+ * - 정렬하지 않는다 (레코드 필드는 memcpy로 읽음, record.h 참고).
+ */
+class Arena {
+private:
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t current;        // 채우는 중인 청크 (chunks가 비어 있으면 0)
+    char* ptr;             // 현재 청크의 다음 할당 위치
+    char* end;             // 현재 청크 끝
+    size_t used_bytes;     // allocate()로 내준 바이트 합
+    size_t reserved_bytes; // 청크 크기 합
+    size_t next_chunk;     // 다음에 새로 잡을 청크 크기
+
+    // 현재 청크에 n바이트가 없을 때: 뒤에 남은 청크 중 들어가는 것, 없으면 새 청크
+    char* allocateSlow(size_t n);
+
+    // size 바이트 청크를 끝에 추가하고 현재 청크로 만듦
+    void addChunk(size_t size);
+
+public:
+    static const size_t MIN_CHUNK = 64 * 1024;
+    static const size_t MAX_CHUNK = 1024 * 1024;
+
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&& other) noexcept;
+    Arena& operator=(Arena&& other) noexcept;
+
+    // n바이트 공간 (내용은 정해지지 않음)
+    char* allocate(size_t n) {
+        if (static_cast<size_t>(end - ptr) >= n) {
+            char* p = ptr;
+            ptr += n;
+            used_bytes += n;
+            return p;
+        }
+        return allocateSlow(n);
+    }
+
+    // 이후 bytes바이트를 새 청크 없이 받을 수 있도록 미리 확보
+    void reserve(size_t bytes);
+
+    // 청크는 유지하고 처음부터 다시 할당 (이전 주소는 무효)
+    // 다시 같은 순서로 할당하면 각 할당 위치는 예전 위치보다 앞이므로
+    // 앞에서부터 memmove하여 제자리 압축할 수 있다 (FlatHashTable::removeKeys)
+    void rewind();
+
+    // 현재 청크 뒤의 (rewind 후 쓰이지 않은) 청크 해제
+    void trim();
+
+    // 모든 청크 해제
+    void release();
+
+    size_t getUsedBytes() const { return used_bytes; }
+    size_t getReservedBytes() const { return reserved_bytes; }
+    size_t getChunkCount() const { return chunks.size(); }
+};
+
+#endif // ARENA_H
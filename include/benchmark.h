@@ -0,0 +1,42 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "common.h"
+#include <string>
+
+/**
+ * ============================================================================
+ * 마이크로벤치마크
+ * ============================================================================
+ *
+ * 조인 전체가 아니라 개별 자료구조/경로의 처리량과 메모리를 측정한다.
+ * 최대 RSS를 비교할 때는 측정 대상마다 fork한 자식 프로세스에서 실행하여
+ * 앞선 측정이 남긴 힙이 다음 측정에 섞이지 않도록 한다.
+ */
+class Benchmark {
+public:
+    // Hash Join Build 측 해시 테이블 비교: FlatHashTable vs unordered_map<int_t, vector<Record>>
+    // Build 테이블로 구축 시간, Probe 테이블 키로 probe 처리량, 메모리/최대 RSS 증가량 측정
+    static void hashTables(const std::string& build_file,
+                           const std::string& probe_file,
+                           const std::string& build_type,
+                           const std::string& probe_type,
+                           const std::string& join_key,
+                           size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    // 블록 I/O 백엔드 비교: ifstream / pread / io_uring (각각 버퍼드, O_DIRECT)
+    // 매 측정 전에 posix_fadvise(DONTNEED)로 파일의 페이지 캐시를 비우고 전체 스캔
+    static void ioBackends(const std::string& table_file,
+                           size_t block_size = DEFAULT_BLOCK_SIZE,
+                           size_t queue_depth = 32);
+
+    // TBL 파싱 처리량 비교: 기존 fromCSV 경로 / TBLParser (scalar, SSE2, AVX2 구분자 탐색)
+    // 파일을 메모리에 올린 뒤 변환과 같은 크기의 청크로 파싱만 측정 (디스크 I/O 제외)
+    static void ingest(const std::string& tbl_file, const std::string& table_type);
+
+    // 블록 할당/초기화 비교: 블록마다 posix_memalign + 전체 memset (이전 방식) /
+    // BlockPool 버퍼 재사용 + 헤더만 쓰는 clear(). 0으로 채운 바이트로 절약한 대역폭 계산
+    static void blockPool(size_t block_size = DEFAULT_BLOCK_SIZE, size_t iterations = 1000000);
+};
+
+#endif // BENCHMARK_H
@@ -2,17 +2,59 @@
 #define BLOCK_H
 
 #include "common.h"
+#include "block_pool.h"
 #include <vector>
 #include <cstddef>
 
-// 고정 크기 블록 클래스
+// 레코드 식별자 (페이지 번호, 슬롯 번호)
+struct RecordId {
+    uint32_t page_no;
+    uint32_t slot_no;
+
+    RecordId() : page_no(0), slot_no(0) {}
+    RecordId(uint32_t page, uint32_t slot) : page_no(page), slot_no(slot) {}
+};
+
+/**
+ * 고정 크기 슬롯 페이지 (Slotted Page)
+ *
+ * 디스크/메모리 상 레이아웃 (항상 정확히 block_size 바이트):
+ *
+ *   [PageHeader][record 0][record 1]...  (free space)  ...[slot 1][slot 0]
+ *   ^0          ^PAGE_HEADER_SIZE        ^free_offset             ^block_size
+ *
+ * - PageHeader: record_count(4 bytes) | free_offset(4 bytes)
+ * - 레코드 데이터는 헤더 뒤에서부터 앞쪽으로 채워짐
+ * - 슬롯 배열은 페이지 끝에서부터 뒤쪽으로 자람
+ *   slot i: offset(4 bytes) | length(4 bytes), 위치 = block_size - (i+1) * SLOT_SIZE
+ *
+ * 헤더가 페이지 안에 저장되므로 디스크에서 읽은 페이지는 그대로 해석 가능하고,
+ * (page_no, slot_no)만으로 한 번의 위치 지정 읽기로 레코드를 찾을 수 있다.
+ *
+ * 버퍼는 블록 크기별 공유 BlockPool에서 받아 소멸 시 돌려준다 (block_pool.h).
+ * 재사용 버퍼에는 이전 내용이 남아 있으므로 clear()는 헤더만 쓰고, 빈 공간
+ * (레코드 영역 끝 ~ 슬롯 배열 시작)은 기록 직전에 zeroFreeSpace()로 채운다.
+ *
+ * 뷰 모드: attach()로 외부 페이지(예: mmap된 파일)를 복사 없이 가리킬 수 있다.
+ * 뷰는 읽기 전용이며, 자체 버퍼는 그대로 유지되어 clear()나 쓰기용 getData()
+ * 호출 시 다시 자체 버퍼로 돌아간다 (할당 없음).
+ */
 class Block {
 private:
-    char* data;           // 블록 데이터
+    char* data;           // 블록 데이터 (헤더 + 레코드 + 슬롯 배열), 뷰이면 외부 페이지
+    char* own_data;       // 자체 버퍼 (pool에서 받음)
     size_t block_size;    // 블록 크기
-    size_t used_size;     // 사용된 크기
+    BlockPool* pool;      // own_data를 돌려줄 풀
+
+    // 헤더 필드 접근
+    uint32_t readHeader(size_t field_offset) const;
+    void writeHeader(size_t field_offset, uint32_t value);
 
 public:
+    static const size_t PAGE_HEADER_SIZE = 2 * sizeof(uint32_t);
+    static const size_t SLOT_SIZE = 2 * sizeof(uint32_t);
+    static const size_t IO_ALIGNMENT = 4096;   // 데이터 버퍼 정렬 (O_DIRECT용)
+
     Block(size_t size = DEFAULT_BLOCK_SIZE);
     ~Block();
 
@@ -24,25 +66,47 @@ public:
     Block(Block&& other) noexcept;
     Block& operator=(Block&& other) noexcept;
 
-    // 블록에 데이터 추가
+    // 블록에 레코드 추가 (레코드 데이터 + 슬롯 1개)
     bool append(const char* record_data, size_t record_size);
 
-    // 블록 초기화
+    // record_size 바이트 공간과 슬롯을 예약하고 쓰기 위치 반환 (공간 부족 시 nullptr)
+    char* allocateRecord(size_t record_size);
+
+    // 블록 초기화: 빈 페이지 헤더만 기록 (O(1), 뷰이면 자체 버퍼로 돌아감)
     void clear();
 
+    // 빈 공간을 0으로 채움 (디스크 기록 전, 이전 사용 내용이 파일에 남지 않도록).
+    // 헤더/레코드/슬롯은 바뀌지 않으므로 const이며, 뷰이면 아무것도 하지 않음
+    void zeroFreeSpace() const;
+
+    // 외부 페이지를 복사 없이 가리키기 (page는 block_size 바이트, 뷰 사용 중 유지되어야 함)
+    void attach(const char* page) { data = const_cast<char*>(page); }
+
+    // 외부 페이지를 가리키는 중인지
+    bool isView() const { return data != own_data; }
+
+    // 디스크에서 읽은 페이지의 헤더/슬롯 배열이 올바른지 검사
+    bool isValid() const;
+
+    // 슬롯 접근
+    size_t getRecordCount() const;
+    const char* getRecord(size_t slot_no, size_t& length) const;
+
     // 블록 데이터 접근
     const char* getData() const { return data; }
-    char* getData() { return data; }
+    char* getData() { data = own_data; return data; }   // 쓰기용: 뷰 해제
     size_t getSize() const { return block_size; }
-    size_t getUsedSize() const { return used_size; }
-    size_t getFreeSize() const { return block_size - used_size; }
-    bool isEmpty() const { return used_size == 0; }
+    size_t getUsedSize() const;
+    size_t getFreeSize() const { return block_size - getUsedSize(); }
+    bool isEmpty() const { return getRecordCount() == 0; }
     bool isFull(size_t required_size) const {
-        return getFreeSize() < required_size;
+        return getFreeSize() < required_size + SLOT_SIZE;
     }
 
-    // 사용된 크기 설정 (파일에서 읽을 때 사용)
-    void setUsedSize(size_t size) { used_size = size; }
+    // 한 페이지에 담을 수 있는 최대 레코드 크기
+    static size_t maxRecordSize(size_t blk_size) {
+        return blk_size - PAGE_HEADER_SIZE - SLOT_SIZE;
+    }
 };
 
 // 블록 관리자 클래스
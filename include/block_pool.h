@@ -0,0 +1,69 @@
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include "common.h"
+#include <mutex>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 블록 메모리 풀 (BlockPool)
+ * ============================================================================
+ *
+ * Block의 데이터 버퍼를 블록 크기별 풀에서 받는다. 풀은 2MB 단위 슬랩을 mmap으로
+ * 잡아 블록 크기(IO_ALIGNMENT 배수로 올림) 간격으로 잘라 쓰고, 반환된 버퍼는
+ * 자유 목록(LIFO, 최근 반환된 캐시에 남은 버퍼 먼저)에 보관했다가 다시 내준다.
+ *
+ * - 블록마다 posix_memalign / free를 하지 않는다. 슬랩은 프로세스가 끝날 때까지
+ *   유지되므로 풀 크기는 동시에 살아 있던 블록 수의 최댓값을 따른다.
+ * - 새 슬랩은 mmap이 0으로 채워 주고, 재사용 버퍼는 이전 내용이 남아 있다.
+ *   Block::clear()는 헤더만 쓰며, 디스크에 기록하기 전 빈 공간은
+ *   Block::zeroFreeSpace()로 채운다 (파일 내용은 예전과 바이트 단위로 같음).
+ * - huge page: setHugePages(true) 뒤에 잡는 슬랩은 MAP_HUGETLB를 먼저 시도하고,
+ *   예약된 huge page가 없으면 일반 매핑에 MADV_HUGEPAGE(THP)를 건다.
+ * - 여러 스레드가 블록을 만들고 지우므로 풀 연산은 mutex로 보호한다.
+ */
+class BlockPool {
+private:
+    size_t block_size;
+    size_t stride;                    // 블록 간격 (IO_ALIGNMENT 배수)
+    size_t slab_bytes;                // 슬랩 크기 (2MB 배수)
+    std::vector<char*> free_list;     // 반환된 버퍼
+    std::vector<char*> slabs;
+    size_t huge_slabs;                // MAP_HUGETLB로 잡은 슬랩 수
+    size_t in_use;                    // 내준 뒤 아직 반환되지 않은 버퍼 수
+    mutable std::mutex mutex;
+
+    // 슬랩 하나를 잡아 자유 목록에 추가 (mutex를 잡은 상태에서 호출)
+    void addSlab();
+
+public:
+    static const size_t SLAB_ALIGNMENT = 2 * 1024 * 1024;   // x86-64 huge page 크기
+
+    explicit BlockPool(size_t blk_size);
+    ~BlockPool();
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    // 블록 크기 바이트 버퍼 하나 (IO_ALIGNMENT 정렬, 내용은 정해지지 않음)
+    char* allocate();
+
+    // allocate()로 받은 버퍼 반환
+    void release(char* buffer);
+
+    size_t getBlockSize() const { return block_size; }
+    size_t getSlabCount() const;
+    size_t getHugeSlabCount() const;
+    size_t getBlocksInUse() const;
+    size_t getCapacity() const;       // 슬랩에 들어 있는 전체 버퍼 수
+
+    // 블록 크기별 공유 풀 (Block 생성자가 사용, 프로세스 끝까지 해제하지 않음)
+    static BlockPool& forSize(size_t blk_size);
+
+    // 이후 새로 잡는 슬랩에 huge page 사용 (기본: 끔)
+    static void setHugePages(bool enabled);
+    static bool getHugePages();
+};
+
+#endif // BLOCK_POOL_H
@@ -3,8 +3,14 @@
 
 #include "common.h"
 #include "block.h"
-#include <vector>
+#include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class BlockSource;
 
 // 버퍼 풀 관리자
 class BufferManager {
@@ -32,4 +38,110 @@ public:
     }
 };
 
+/**
+ * ============================================================================
+ * 페이지 버퍼 풀 (BufferPool)
+ * ============================================================================
+ *
+ * BufferManager가 위치로만 구분하는 블록 배열이라면, BufferPool의 프레임은 어떤
+ * (파일, 페이지)를 담고 있는지 기억한다. 페이지 테이블 (파일, 페이지) → 프레임으로
+ * 이미 올라온 페이지는 다시 읽지 않는다.
+ *
+ *   Block* page = pool.pin(reader, file_id, page_no);   // 없으면 읽어 옴
+ *   ... page 사용 ...
+ *   pool.unpin(file_id, page_no, dirty);
+ *
+ * - pin된 프레임(pin_count > 0)은 교체 대상이 아니며, 모든 프레임이 pin이면 예외.
+ * - dirty 프레임은 교체되기 전에 write-back 콜백으로 기록 (콜백이 없으면 예외).
+ *   소멸 시에는 기록하지 않으므로 수정한 페이지는 flushAll()로 내보내야 한다.
+ * - 교체 정책:
+ *     CLOCK  참조 비트를 보며 시곗바늘이 도는 LRU 근사
+ *     LRU    가장 오래전에 사용한 프레임
+ *     LRU_K  K번째 최근 사용이 가장 오래된 프레임 (사용이 K번 미만이면 우선,
+ *            그중에서는 LRU; O'Neil et al. 1993, 상관 참조 기간은 두지 않음).
+ *            교체된 페이지의 사용 기록은 마지막 사용 후 RETAINED_PERIOD_FACTOR × 프레임 수
+ *            틱 동안 보관하다가 다시 올라오면 이어 쓴다 (retained information period).
+ *            보관 기록은 그 두 배를 넘으면 기간이 지난 것부터 정리한다.
+ *     MRU    가장 최근에 사용한 프레임. 프레임보다 조금 큰 파일을 반복 순차 스캔할 때
+ *            (BNLJ inner) LRU는 매번 전부 놓치지만 MRU는 프레임 - 1개 페이지를 유지
+ * - 빈 프레임이 있으면 정책과 상관없이 먼저 사용.
+ *
+ * 스레드 안전하지 않다 (병렬 BNLJ는 스레드마다 풀을 따로 둔다).
+ */
+enum class ReplacementPolicy { CLOCK, LRU, LRU_K, MRU };
+
+// "clock", "lru", "lru-k", "mru" (알 수 없으면 예외)
+ReplacementPolicy parseReplacementPolicy(const std::string& name);
+const char* replacementPolicyName(ReplacementPolicy policy);
+
+class BufferPool {
+public:
+    // dirty 페이지 기록 콜백 (file_id, page_no, 페이지 내용)
+    typedef std::function<void(size_t, size_t, const Block&)> WriteBack;
+
+private:
+    struct Frame {
+        std::unique_ptr<Block> block;
+        uint64_t key;                  // 담고 있는 페이지 (valid일 때)
+        bool valid;
+        bool dirty;
+        bool referenced;               // CLOCK 참조 비트
+        size_t pin_count;
+        std::vector<uint64_t> history; // 최근 사용 시각, [0]이 가장 최근 (0 = 없음)
+    };
+
+    std::vector<Frame> frames;
+    std::unordered_map<uint64_t, size_t> page_table;   // 페이지 키 → 프레임 번호
+    std::unordered_map<uint64_t, std::vector<uint64_t>> retained;   // LRU_K: 교체된 페이지 기록
+    uint64_t retained_period;   // 기록 보관 기간 (사용 시각 틱)
+    ReplacementPolicy policy;
+    size_t block_size;
+    size_t history_depth;   // LRU_K의 K (다른 정책은 1)
+    uint64_t clock_tick;    // 사용 시각 카운터
+    size_t hand;            // CLOCK 시곗바늘
+    Statistics* stats;
+    WriteBack write_back;
+
+    static uint64_t pageKey(size_t file_id, size_t page_no);
+
+    // 프레임 사용 기록 (참조 비트, 사용 시각)
+    void touch(Frame& frame);
+
+    // LRU_K: 교체되는 프레임의 사용 기록 보관 / 다시 올라온 페이지의 기록 복원
+    void retainHistory(const Frame& frame);
+    void restoreHistory(Frame& frame);
+
+    // 교체할 프레임 선택 (빈 프레임 우선, 모두 pin이면 예외)
+    size_t findVictim();
+
+    // 프레임의 dirty 페이지 기록
+    void writeFrame(Frame& frame);
+
+public:
+    static const uint64_t RETAINED_PERIOD_FACTOR = 8;
+
+    BufferPool(size_t num_frames, size_t blk_size = DEFAULT_BLOCK_SIZE,
+               ReplacementPolicy replacement = ReplacementPolicy::CLOCK,
+               Statistics* st = nullptr, size_t k = 2);
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // 페이지를 pin하고 프레임 블록 반환 (없으면 source.readBlockAt으로 읽음,
+    // 파일 끝 너머면 nullptr). file_id는 호출자가 파일마다 정하는 번호
+    Block* pin(BlockSource& source, size_t file_id, size_t page_no);
+
+    // pin 해제 (dirty이면 교체/flushAll 때 기록)
+    void unpin(size_t file_id, size_t page_no, bool dirty = false);
+
+    // dirty 프레임을 모두 기록
+    void flushAll();
+
+    void setWriteBack(WriteBack callback) { write_back = std::move(callback); }
+
+    ReplacementPolicy getPolicy() const { return policy; }
+    size_t getFrameCount() const { return frames.size(); }
+    size_t getMemoryUsage() const { return frames.size() * block_size; }
+};
+
 #endif // BUFFER_H
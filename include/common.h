@@ -21,9 +21,39 @@ struct Statistics {
     size_t output_records;
     double elapsed_time;
     size_t memory_usage;
+    size_t spill_block_reads;    // 임시 파티션 파일 읽기 (block_reads에 포함)
+    size_t spill_block_writes;   // 임시 파티션 파일 쓰기 (block_writes에 포함)
+    double io_stall_time;        // 미리 읽기 블록을 기다리며 멈춘 시간 (초)
+    size_t blocks_skipped;       // 존 맵으로 읽지 않고 건너뛴 페이지 수
+    size_t buffer_hits;          // 버퍼 풀에 이미 있던 페이지 요청 수
+    size_t buffer_misses;        // 버퍼 풀이 디스크에서 읽은 페이지 수
+    size_t sort_runs;            // 외부 정렬이 만든 초기 run 수
+    size_t merge_passes;         // 외부 정렬 병합 패스 수 (마지막 출력 패스 포함)
 
     Statistics() : block_reads(0), block_writes(0), output_records(0),
-                   elapsed_time(0.0), memory_usage(0) {}
+                   elapsed_time(0.0), memory_usage(0),
+                   spill_block_reads(0), spill_block_writes(0), io_stall_time(0.0),
+                   blocks_skipped(0), buffer_hits(0), buffer_misses(0),
+                   sort_runs(0), merge_passes(0) {}
+
+    // 다른 통계 합산 (스레드별 통계 집계용, 시간은 가장 긴 쪽)
+    void merge(const Statistics& other) {
+        block_reads += other.block_reads;
+        block_writes += other.block_writes;
+        output_records += other.output_records;
+        memory_usage += other.memory_usage;
+        spill_block_reads += other.spill_block_reads;
+        spill_block_writes += other.spill_block_writes;
+        io_stall_time += other.io_stall_time;
+        blocks_skipped += other.blocks_skipped;
+        buffer_hits += other.buffer_hits;
+        buffer_misses += other.buffer_misses;
+        sort_runs += other.sort_runs;
+        merge_passes += other.merge_passes;
+        if (other.elapsed_time > elapsed_time) {
+            elapsed_time = other.elapsed_time;
+        }
+    }
 };
 
 #endif // COMMON_H
@@ -0,0 +1,113 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include "common.h"
+#include "table.h"
+#include "buffer.h"
+#include <string>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 외부 병합 정렬 (External Merge Sort)
+ * ============================================================================
+ *
+ * 메모리 예산 B 블록 (--buffer-size)으로 임의 크기 테이블을 한 컬럼 기준 오름차순 정렬.
+ *
+ * 1. Run 생성 (replacement selection):
+ *    입력 1블록 + run 출력 1블록 + 작업 공간 B-2블록. 작업 공간의 레코드를
+ *    (run 번호, 키) 최소 힙으로 관리하며, 최솟값을 현재 run에 내보낸 자리에 다음 입력
+ *    레코드를 넣는다. 새 레코드의 키가 마지막으로 내보낸 키보다 작으면 다음 run으로
+ *    미룬다. 무작위 입력이면 run 길이가 평균 작업 공간의 약 2배이고 (Knuth 5.4.1),
+ *    이미 정렬된 입력은 run 하나가 된다.
+ * 2. 병합: run을 B-1개씩 loser tree로 k-way 병합 (입력마다 1블록 + 출력 1블록).
+ *    run이 B-1개 이하가 될 때까지 임시 파일로 병합 패스를 반복하고, 마지막 패스는
+ *    출력 파일에 쓴다. run이 하나뿐이면 병합 없이 출력 파일로 이름만 바꾼다.
+ *    출력의 .meta/.zones는 마지막 병합 (또는 첫 run)을 쓰면서 모아 함께 기록한다.
+ *
+ * I/O 비용: N = 입력 블록 수, R = 초기 run 수, P = ⌈log_{B-1} R⌉ 병합 패스
+ *   N (입력 읽기) + N (run 쓰기) + P × 2N
+ * 교과서 비용 2N(1 + ⌈log_{B-1} ⌈N/B⌉⌉)은 B블록 run을 가정하므로, replacement
+ * selection으로 run 수가 줄면 같거나 작다 (통계에 둘 다 출력).
+ *
+ * --io-backend uring: 리더/라이터는 요청마다 창 블록을 따로 잡으므로 깊이를 1로 줄이고
+ * 창 블록도 B에서 뺀다. run 생성은 작업 공간이 2블록 줄고, 병합은 입력마다 2블록이 들어
+ * fan-in이 B/2 - 1이 된다. 그 때문에 병합 패스가 늘어나면 창 없이 pread로 병합한다.
+ *
+ * .tbl 입력은 파싱하며 읽으므로 리더의 파싱 버퍼 ((2 × --parse-threads + 1) × 4 MB까지)가
+ * B 밖에서 더 들며, 메모리 사용량에 더해 보고한다.
+ *
+ * 키 컬럼은 INT / DECIMAL / STRING 모두 가능 (STRING은 바이트 사전순).
+ * 같은 키의 순서는 정해지지 않는다.
+ */
+
+class SidecarSink;
+
+// 디스크에 기록된 정렬된 run
+struct SortedRun {
+    std::string file;
+    size_t blocks;
+    size_t records;
+
+    SortedRun() : blocks(0), records(0) {}
+};
+
+class ExternalSort {
+private:
+    std::string input_file;
+    std::string output_file;
+    std::string table_type;
+    std::string sort_key;          // 정렬 키 컬럼 이름
+    size_t buffer_size;            // 메모리 예산 (블록 개수, 최소 3)
+    size_t block_size;
+    const Schema* schema;
+    size_t key_col;                // 정렬 키 컬럼 인덱스
+    FieldType key_type;
+    Statistics stats;
+    Statistics spill_stats;        // run 임시 파일 I/O (execute 끝에 stats로 합산)
+
+    // 실행 요약
+    size_t input_blocks;           // N
+    size_t input_records;
+    size_t initial_runs;           // run 생성 단계에서 만든 run 수
+    size_t initial_run_blocks;     // 초기 run 블록 수 합
+    size_t workspace_blocks;       // replacement selection 작업 공간 블록 수
+    size_t merge_fanin;            // 병합 한 번의 최대 입력 수 (창이 없으면 B-1)
+    size_t run_window;             // run 생성 리더/라이터당 io_uring 창 블록 수
+    size_t merge_window;           // 병합 리더/라이터당 io_uring 창 블록 수
+    size_t compactions;            // replacement selection 작업 공간 압축 횟수
+    size_t parse_memory;           // .tbl 입력 리더의 파싱 버퍼 최대 바이트 수 (B와 별도)
+    double run_time;               // run 생성 시간 (초)
+    double merge_time;             // 병합 시간 (초)
+
+    // 두 레코드의 키 비교 (<0, 0, >0)
+    int compareKeys(const RecordView& a, const RecordView& b) const;
+
+    // 임시 run 파일 이름 (output_file.run.<패스>_<번호>.tmp)
+    std::string runFileName(size_t pass, size_t index) const;
+
+    // 입력 전체를 replacement selection으로 정렬된 run 파일들로 나눔
+    // (첫 run의 블록은 first_run을 거쳐 기록: run이 하나뿐이면 그대로 출력이 됨)
+    std::vector<SortedRun> generateRuns(BufferManager& buffers, const IoOptions& io,
+                                        SidecarSink& first_run,
+                                        std::vector<std::string>& temp);
+
+    // inputs를 loser tree로 병합하여 writer에 기록 (buffers 앞쪽 inputs.size()+1개 사용)
+    SortedRun mergeRuns(const std::vector<SortedRun>& inputs, BufferManager& buffers,
+                        const IoOptions& io, BlockSink& writer);
+
+    void printStatistics() const;
+
+public:
+    ExternalSort(const std::string& in_file,
+                 const std::string& out_file,
+                 const std::string& type,
+                 const std::string& key_name,
+                 size_t buf_size,
+                 size_t blk_size = DEFAULT_BLOCK_SIZE);
+
+    void execute();
+    const Statistics& getStatistics() const { return stats; }
+};
+
+#endif // EXTERNAL_SORT_H
@@ -0,0 +1,139 @@
+#ifndef EXTERNAL_TABLE_READER_H
+#define EXTERNAL_TABLE_READER_H
+
+#include "common.h"
+#include "block.h"
+#include "table.h"
+#include "tbl_parser.h"
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 외부 테이블 리더 (.tbl 파일을 변환 없이 블록으로 스캔)
+ * ============================================================================
+ *
+ * 파이프 구분 텍스트를 읽으면서 TBLParser로 파싱하고, --convert가 만드는 .dat와
+ * 같은 페이지를 그 자리에서 채워 준다. 앞쪽 청크를 최대 parse_threads개까지
+ * 백그라운드에서 병렬 파싱하며 (std::async), 결과는 입력 순서대로 소비한다.
+ *
+ * 페이지 번호 접근 (readBlockAt, getBlockCount)에는 페이지 k의 첫 레코드가 시작하는
+ * 원본 줄 위치를 담은 페이지 색인이 필요하다. 색인은 처음부터 끝까지 스캔하면 그 과정에서
+ * 만들어지고, 아직 없을 때 요청되면 별도 스캔으로 만든다. 완성된 색인은
+ * (파일, 타입, 블록 크기, 파일 크기/수정 시각) 단위로 프로세스 안에서 공유하므로,
+ * 스레드마다 리더를 여는 병렬 조인도 색인 스캔은 한 번만 한다.
+ *
+ * 스캔할 때마다 다시 파싱하므로, BNLJ inner처럼 여러 번 스캔되는 입력은 한 번
+ * 변환해 두는 편이 빠르다.
+ *
+ * 파싱 대기 청크마다 텍스트와 인코딩 결과를 함께 들고 있으므로 리더 하나가 최대
+ * (2 × parse_threads + 1) × 4 MB를 쓴다 (getMemoryUsage). 블록 예산과는 별개이므로
+ * BNLJ와 외부 정렬은 미리 읽기 링, io_uring 창과 같이 메모리 사용량에 더해 보고한다.
+ */
+class ExternalTableReader : public BlockSource {
+private:
+    typedef std::vector<uint64_t> PageIndex;
+
+    // 파싱된 청크 (base = 청크 첫 바이트의 파일 위치)
+    struct ParsedChunk {
+        uint64_t base;
+        uint64_t end;
+        TBLParser::Output parsed;
+    };
+
+    std::string filename;
+    std::string table_type;
+    size_t block_size;
+    Statistics* stats;
+    size_t parse_threads;
+    int fd;
+    uint64_t file_size;
+    int64_t file_mtime_ns;
+
+    // 순차 스캔 상태
+    uint64_t read_offset;                         // 다음 청크를 읽을 파일 위치
+    size_t chunk_size;                            // 다음 청크 크기 (위치 이동 후 작게 시작)
+    std::deque<std::future<ParsedChunk>> pending; // 파싱 중인 청크 (입력 순서)
+    ParsedChunk current;
+    size_t current_record;
+    const char* current_data;
+    bool has_current;
+    size_t next_page;
+    uint64_t reported_offset;                     // 이 위치 앞의 파싱 오류는 이미 출력함
+
+    // 페이지 색인
+    mutable std::shared_ptr<const PageIndex> index;   // 완성된 색인 (없으면 nullptr)
+    PageIndex building;                               // 0번 페이지부터 스캔하며 쌓는 색인
+    bool publish_index;                               // 스캔 완료 시 색인을 공유 캐시에 등록
+
+    // 백그라운드 파싱 작업
+    static ParsedChunk parseChunk(uint64_t base, uint64_t end, const std::string& type,
+                                  const std::string& text);
+
+    // 청크 하나를 줄 경계까지 읽음 (다음 청크 위치 반환)
+    uint64_t readChunkText(uint64_t offset, size_t size, std::string& text) const;
+
+    // 파싱 대기열을 parse_threads개까지 채움
+    void fillPending();
+
+    // current를 다음 파싱 결과로 교체 (입력 끝이면 false)
+    bool nextChunk();
+
+    // 페이지 page가 원본 offset에서 시작하도록 스캔 위치 이동
+    void seek(uint64_t offset, size_t page);
+
+    // 색인 확보 (공유 캐시 또는 별도 전체 스캔)
+    const PageIndex& loadIndex() const;
+    std::string cacheKey() const;
+
+    // 다음 페이지 채우기
+    bool fillPage(Block* block);
+
+public:
+    static const size_t MAX_CHUNK_SIZE = 4 * 1024 * 1024;   // 순차 스캔 청크 크기 상한
+
+    ExternalTableReader(const std::string& fname, const std::string& type,
+                        size_t blk_size = DEFAULT_BLOCK_SIZE, Statistics* st = nullptr,
+                        size_t threads = 0);
+    ~ExternalTableReader();
+
+    ExternalTableReader(const ExternalTableReader&) = delete;
+    ExternalTableReader& operator=(const ExternalTableReader&) = delete;
+
+    bool readBlock(Block* block) override;
+    bool readBlockAt(size_t page_no, Block* block) override;
+    void reset() override;
+
+    // 페이지 수 (색인이 없으면 전체 스캔 한 번으로 만듦)
+    size_t getBlockCount() const override;
+
+    // 페이지 수 추정 (색인이 있으면 정확한 값, 없으면 파싱 없이 텍스트 크기로 어림)
+    size_t estimateBlockCount() const;
+
+    // 파싱 버퍼 최대 바이트 수 (대기 청크의 텍스트 + 인코딩 결과, 현재 청크)
+    size_t getMemoryUsage() const { return (2 * parse_threads + 1) * MAX_CHUNK_SIZE; }
+};
+
+// 외부 테이블 파일인지 (.tbl 확장자)
+bool isExternalTable(const std::string& file);
+
+// 외부 테이블 파싱 스레드 수 기본값 (0 = 하드웨어 스레드 수)
+void setExternalParseThreads(size_t threads);
+size_t getExternalParseThreads();
+
+// 입력 블록 수: 블록 파일은 파일 크기로 정확히, .tbl은 estimateBlockCount()
+// (크기로 파티션 수를 정할 때 .tbl을 미리 한 번 파싱하지 않도록)
+size_t estimateTableBlocks(const std::string& file, const std::string& table_type,
+                           size_t block_size);
+
+// 블록 파일이면 TableReader, .tbl이면 ExternalTableReader
+// (parse_threads: 외부 테이블 파싱 스레드 수, 0 = 기본값)
+std::unique_ptr<BlockSource> openTableSource(const std::string& file,
+                                             const std::string& table_type,
+                                             size_t block_size, Statistics* stats,
+                                             size_t parse_threads = 0);
+
+#endif // EXTERNAL_TABLE_READER_H
@@ -22,7 +22,7 @@
  * 사용 예제:
  *   FileManager fm(4096, 10);  // 4KB 블록, 10개 버퍼
  *   fm.convertCSV("part.tbl", "part.dat", "PART");
- *   fm.readBlockFile("part.dat", [](const PartRecord& record) {
+ *   fm.readPartRecords("part.dat", [](const PartRecord& record) {
  *       std::cout << record.name << std::endl;
  *   });
  */
@@ -70,17 +70,19 @@ public:
      * 블록 파일에서 모든 레코드를 읽어 콜백 함수 실행
      *
      * @param block_file 블록 파일 경로
+     * @param table_type 테이블 타입 (행 형식 해석에 사용)
      * @param callback 각 레코드에 대해 호출될 함수
      * @return 읽은 레코드 개수
      * @throws std::runtime_error 파일 오류
      *
      * 사용 예제:
-     *   fm.readBlockFile("part.dat", [](const Record& rec) {
+     *   fm.readBlockFile("part.dat", "PART", [](const Record& rec) {
      *       PartRecord part = PartRecord::fromRecord(rec);
      *       std::cout << part.name << std::endl;
      *   });
      */
     size_t readBlockFile(const std::string& block_file,
+                        const std::string& table_type,
                         std::function<void(const Record&)> callback);
 
     /**
@@ -193,6 +195,7 @@ public:
 
     /**
      * 블록 파일의 레코드 개수 카운트
+     * (메타데이터 파일이 있으면 스캔 없이 O(1))
      *
      * @param block_file 블록 파일 경로
      * @return 레코드 개수
@@ -201,6 +204,7 @@ public:
 
     /**
      * 블록 파일의 블록 개수 카운트
+     * (메타데이터 파일이 있으면 스캔 없이 O(1))
      *
      * @param block_file 블록 파일 경로
      * @return 블록 개수
@@ -0,0 +1,163 @@
+#ifndef FLAT_HASH_TABLE_H
+#define FLAT_HASH_TABLE_H
+
+#include "common.h"
+#include "arena.h"
+#include <cstring>
+#include <vector>
+
+/**
+ * ============================================================================
+ * Hash Join Build 측용 개방 주소법 해시 테이블
+ * ============================================================================
+ *
+ * 레이아웃:
+ *   slots   : 2의 거듭제곱 크기 배열, 슬롯 = (key, 첫 엔트리 인덱스)
+ *   entries : 레코드마다 (arena 내 주소, 길이, 같은 키의 다음 엔트리 인덱스)
+ *   arena   : 레코드 바이트를 삽입 순서대로 이어 붙이는 청크 arena (arena.h)
+ *
+ * 선형 탐사로 키 슬롯을 찾고, 같은 키의 레코드들은 엔트리 인덱스로 연결한다.
+ * 키/레코드마다 힙 할당이 없고, probe 한 번은 슬롯 배열 → 엔트리 → arena의
+ * 연속 메모리만 접근한다. arena는 자랄 때 기존 바이트를 복사하지 않으며,
+ * 테이블의 레코드 바이트 전체가 clear()/소멸 때 한 번에 반환된다. 슬롯 위치는 Fibonacci 해싱(곱셈 해시의 상위 비트)으로 정한다.
+ */
+class FlatHashTable {
+public:
+    static const uint32_t NONE = UINT32_MAX;   // 빈 슬롯 / 체인 끝
+
+private:
+    struct Slot {
+        int_t key;
+        uint32_t head;     // 이 키의 첫 엔트리 (NONE이면 빈 슬롯)
+    };
+
+    struct Entry {
+        const char* data;  // arena 내 레코드 시작
+        uint32_t size;     // 레코드 길이
+        uint32_t next;     // 같은 키의 다음 엔트리
+    };
+
+    std::vector<Slot> slots;
+    std::vector<Entry> entries;
+    Arena arena;
+    size_t mask;           // slots.size() - 1
+    unsigned shift;        // 32 - log2(slots.size())
+    size_t key_count;
+
+    size_t slotOf(int_t key) const {
+        return (static_cast<uint32_t>(key) * 0x9E3779B1u) >> shift;
+    }
+
+    // 슬롯 배열을 capacity(2의 거듭제곱)로 다시 만들고 기존 키 재배치
+    void rehash(size_t capacity);
+
+public:
+    // 최대 적재율 (키 수 / 슬롯 수)
+    static const double MAX_LOAD;
+
+    FlatHashTable();
+
+    // 예상 레코드 수/바이트 수로 미리 할당 (키 수 ≤ 레코드 수로 보고 슬롯 배열 크기 결정)
+    void reserve(size_t records, size_t payload_bytes);
+
+    // 레코드 바이트를 arena로 복사하고 key 체인에 추가
+    void insert(int_t key, const char* data, size_t size);
+
+    // key의 첫 엔트리 (없으면 NONE)
+    uint32_t find(int_t key) const {
+        size_t i = slotOf(key);
+        while (true) {
+            const Slot& slot = slots[i];
+            if (slot.head == NONE) return NONE;
+            if (slot.key == key) return slot.head;
+            i = (i + 1) & mask;
+        }
+    }
+
+    uint32_t next(uint32_t entry) const { return entries[entry].next; }
+    const char* payload(uint32_t entry) const { return entries[entry].data; }
+    size_t payloadSize(uint32_t entry) const { return entries[entry].size; }
+
+    // should_remove(key)가 참인 키의 레코드를 on_removed(key, data, size)로 넘기고 제거
+    // (남은 레코드는 arena 앞쪽으로 압축하고 비게 된 청크는 해제)
+    template <typename Pred, typename Fn>
+    void removeKeys(Pred should_remove, Fn on_removed);
+
+    // 모든 키 제거 (슬롯 배열과 arena 청크는 다음 구축을 위해 유지)
+    void clear();
+
+    // 모든 키 제거 후 arena 청크까지 해제
+    void release();
+
+    size_t getKeyCount() const { return key_count; }
+    size_t getRecordCount() const { return entries.size(); }
+    size_t getCapacity() const { return slots.size(); }
+
+    // 사용 중인 메모리 (슬롯 배열 전체 + 엔트리 + arena 데이터)
+    size_t getMemoryUsage() const {
+        return slots.size() * sizeof(Slot) + entries.size() * sizeof(Entry) +
+               arena.getUsedBytes();
+    }
+
+    // arena가 잡아 둔 메모리 (사용량 + 청크 하나 이하)
+    size_t getArenaReserved() const { return arena.getReservedBytes(); }
+};
+
+template <typename Pred, typename Fn>
+void FlatHashTable::removeKeys(Pred should_remove, Fn on_removed) {
+    std::vector<Slot> kept;
+    std::vector<bool> dropped(entries.size(), false);
+
+    for (const Slot& slot : slots) {
+        if (slot.head == NONE) continue;
+
+        if (!should_remove(slot.key)) {
+            kept.push_back(slot);
+            continue;
+        }
+        for (uint32_t e = slot.head; e != NONE; e = entries[e].next) {
+            on_removed(slot.key, payload(e), entries[e].size);
+            dropped[e] = true;
+        }
+    }
+
+    // 엔트리는 arena 할당 순서와 같으므로 arena를 되감고 같은 순서로 다시 할당하면
+    // 새 위치가 항상 원래 위치보다 앞이라 덮어쓰기 없이 제자리 압축됨
+    std::vector<uint32_t> remap(entries.size(), NONE);
+    size_t out = 0;
+    arena.rewind();
+    for (size_t e = 0; e < entries.size(); ++e) {
+        if (dropped[e]) continue;
+
+        Entry entry = entries[e];
+        char* dest = arena.allocate(entry.size);
+        std::memmove(dest, entry.data, entry.size);
+        entry.data = dest;
+
+        remap[e] = static_cast<uint32_t>(out);
+        entries[out++] = entry;
+    }
+    entries.resize(out);
+    arena.trim();
+
+    for (Entry& entry : entries) {
+        if (entry.next != NONE) entry.next = remap[entry.next];
+    }
+
+    // 남은 키로 슬롯 배열 재구성
+    for (Slot& slot : slots) {
+        slot.head = NONE;
+    }
+    key_count = 0;
+    for (const Slot& slot : kept) {
+        size_t i = slotOf(slot.key);
+        while (slots[i].head != NONE) {
+            i = (i + 1) & mask;
+        }
+        slots[i].key = slot.key;
+        slots[i].head = remap[slot.head];
+        key_count++;
+    }
+}
+
+#endif // FLAT_HASH_TABLE_H
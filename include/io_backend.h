@@ -0,0 +1,120 @@
+#ifndef IO_BACKEND_H
+#define IO_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * ============================================================================
+ * 블록 I/O 백엔드
+ * ============================================================================
+ *
+ * TableReader / TableWriter가 페이지를 실제로 읽고 쓰는 방식:
+ *   - STREAM : std::ifstream / std::ofstream (기존 방식, 라이브러리 버퍼 경유)
+ *   - PREAD  : pread / pwrite 시스템 호출 (페이지 오프셋 직접 지정)
+ *   - URING  : io_uring으로 여러 블록 요청을 한 번에 제출하고 완료를 모아 받음
+ *              (순차 스캔은 queue_depth개 읽기를 항상 띄워 둠)
+ *
+ * direct = true면 파일을 O_DIRECT로 열어 페이지 캐시를 거치지 않는다. Block 버퍼는
+ * Block::IO_ALIGNMENT 경계에 할당되므로 블록 크기가 512의 배수면 그대로 쓸 수 있다.
+ * io_uring을 쓸 수 없는 커널/샌드박스에서는 PREAD로 대체한다.
+ */
+enum class IoBackend {
+    STREAM,
+    PREAD,
+    URING
+};
+
+struct IoOptions {
+    IoBackend backend;
+    bool direct;              // O_DIRECT (PREAD / URING만 해당)
+    size_t queue_depth;       // URING: 리더/라이터당 동시에 띄우는 요청 수
+
+    IoOptions() : backend(IoBackend::STREAM), direct(false), queue_depth(32) {}
+};
+
+// 이름("stream", "pread", "uring") ↔ 백엔드
+IoBackend parseIoBackend(const std::string& name);
+const char* ioBackendName(IoBackend backend);
+
+// 이후 생성되는 TableReader / TableWriter의 기본 I/O 설정 (main에서 한 번 지정)
+void setDefaultIoOptions(const IoOptions& options);
+const IoOptions& getDefaultIoOptions();
+
+// 요청한 설정을 이 환경에서 쓸 수 있는 설정으로 조정 (io_uring 불가 → PREAD 등)
+IoOptions resolveIoOptions(const IoOptions& requested, size_t block_size);
+
+// 임시 파일(파티션, 정렬 run) 리더/라이터의 io_uring 요청 수.
+// URING 리더/라이터는 요청마다 창 버퍼 블록을 따로 잡으므로, 한꺼번에 여러 개 열리는
+// 임시 파일은 깊이를 줄여 창 블록까지 메모리 예산 안에 넣는다.
+static const size_t SPILL_QUEUE_DEPTH = 2;
+
+// options에서 io_uring 깊이만 depth로 줄인 설정 (depth 0이면 창 없이 PREAD)
+IoOptions limitQueueDepth(const IoOptions& options, size_t depth);
+
+// 이 설정의 리더/라이터 하나가 io_uring 창 버퍼로 따로 잡는 블록 수 (URING이 아니면 0)
+inline size_t ioWindowBlocks(const IoOptions& options) {
+    return options.backend == IoBackend::URING ? options.queue_depth : 0;
+}
+
+/**
+ * io_uring 최소 래퍼 (liburing 없이 시스템 호출과 mmap으로 직접 구성)
+ *
+ * 제출 큐(SQ)에 읽기/쓰기 요청을 쌓은 뒤 submit()으로 한 번에 커널에 넘기고,
+ * 완료 큐(CQ)에서 (tag, 결과)를 꺼낸다. 한 스레드에서만 사용한다.
+ */
+class IoUring {
+private:
+    int ring_fd;
+    unsigned entries;
+
+    // mmap 영역
+    void* sq_ptr;
+    size_t sq_map_size;
+    void* cq_ptr;
+    size_t cq_map_size;
+    void* sqe_ptr;
+    size_t sqe_map_size;
+
+    // SQ 링 필드
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+
+    // CQ 링 필드
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    void* cqes;
+
+    unsigned pending;         // SQ에 쌓였지만 아직 제출하지 않은 요청 수
+
+    void prep(uint8_t opcode, int fd, void* buf, size_t len, off_t offset, uint64_t tag);
+
+public:
+    explicit IoUring(unsigned queue_entries);
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // 이 환경에서 io_uring_setup이 가능한지 (한 번 검사 후 캐시)
+    static bool isSupported();
+
+    // 요청 추가 (submit 전까지는 커널에 전달되지 않음)
+    void prepRead(int fd, void* buf, size_t len, off_t offset, uint64_t tag);
+    void prepWrite(int fd, const void* buf, size_t len, off_t offset, uint64_t tag);
+
+    // 쌓인 요청을 제출하고 최소 wait_nr개가 완료될 때까지 대기
+    void submit(unsigned wait_nr);
+
+    // 완료 하나 꺼내기 (없으면 false), result는 바이트 수 또는 -errno
+    bool popCompletion(uint64_t& tag, int& result);
+
+    unsigned getEntries() const { return entries; }
+};
+
+#endif // IO_BACKEND_H
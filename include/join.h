@@ -4,7 +4,51 @@
 #include "common.h"
 #include "table.h"
 #include "buffer.h"
+#include "simd_match.h"
+#include "mapped_table_reader.h"
+#include <memory>
 #include <string>
+#include <vector>
+
+// Outer 청크와 Inner 블록의 키 매칭 방식
+enum class ChunkMatchMode {
+    NESTED_LOOP,   // inner 키마다 outer 키 배열 전체 비교 (SIMD 커널)
+    HASH           // outer 청크 위 해시 인덱스로 inner 키마다 1회 조회
+};
+
+/**
+ * ChunkHashIndex - BNLJ outer 청크의 키 배열 위에 만드는 작은 해시 인덱스
+ *
+ * 버킷 헤드 배열(2의 거듭제곱, 항목 수의 2배 이상)과 항목별 next 배열로
+ * 구성된 체이닝 해시. 레코드는 복사하지 않고 키 배열 인덱스만 저장하므로
+ * 청크당 추가 메모리는 레코드당 약 12 바이트이며, 벡터는 청크 간에 재사용된다.
+ */
+class ChunkHashIndex {
+private:
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::vector<uint32_t> heads;   // 버킷 → 첫 항목 인덱스
+    std::vector<uint32_t> next;    // 항목 → 같은 버킷의 다음 항목
+    const int_t* keys;
+    size_t shift;                  // 곱셈 해시의 상위 비트 선택
+
+    size_t bucketOf(int_t key) const {
+        return static_cast<size_t>((static_cast<uint32_t>(key) * 0x9E3779B1u) >> shift);
+    }
+
+public:
+    ChunkHashIndex() : keys(nullptr), shift(32) {}
+
+    // keys[0..n)에 대한 인덱스 구성 (keys는 인덱스 사용 중 유지되어야 함)
+    void build(const int_t* key_data, size_t n);
+
+    // 각 inner 키를 조회하여 매칭 쌍을 sel에 추가 (outer 인덱스 오름차순)
+    void probeBlock(const int_t* inner_keys, size_t inner_n, SelectionVector& sel) const;
+
+    size_t getMemoryUsage() const {
+        return (heads.capacity() + next.capacity()) * sizeof(uint32_t);
+    }
+};
 
 // Block Nested Loops Join 실행자
 class BlockNestedLoopsJoin {
@@ -17,22 +61,60 @@ private:
     std::string join_key;          // 조인 키 필드명 (예: "partkey", "suppkey")
     size_t buffer_size;            // 버퍼 크기 (블록 개수)
     size_t block_size;             // 블록 크기 (바이트)
+    const Schema* outer_schema;    // Outer 테이블 행 형식
+    const Schema* inner_schema;    // Inner 테이블 행 형식
+    Schema output_schema;          // 조인 결과 행 형식 (outer 컬럼 + inner 컬럼)
+    size_t outer_key_col;          // Outer 스키마에서 조인 키 컬럼 인덱스
+    size_t inner_key_col;          // Inner 스키마에서 조인 키 컬럼 인덱스
+    MatchKernel match_kernel;      // 키 비교 커널 (기본: CPU 기능 감지)
+    ChunkMatchMode match_mode;     // 청크 매칭 방식 (기본: nested loop)
+    size_t chunk_index_memory;     // 청크 해시 인덱스 최대 크기 (바이트)
+    size_t num_threads;            // Inner 스캔 작업자 스레드 수 (기본: 1)
+    size_t prefetch_depth;         // 리더당 미리 읽기 블록 수 (0이면 동기 읽기)
+    ScanMethod outer_scan;         // Outer 스캔 방식 (기본: read)
+    ScanMethod inner_scan;         // Inner 스캔 방식 (기본: read)
+    MapOptions map_options;        // mmap 스캔의 madvise / MAP_POPULATE 설정
+    size_t write_behind_blocks;    // write-behind 출력 풀 블록 수 (0이면 동기 기록)
+    size_t parse_memory;           // .tbl 입력 리더들의 파싱 버퍼 최대 바이트 합
+    size_t output_write_calls;     // write-behind pwritev 호출 수
+    double output_stall_time;      // 빈 출력 블록을 기다린 시간 (초)
+    bool use_zone_maps;            // inner 존 맵으로 청크 키 범위 밖 페이지 건너뛰기 (기본: 켬)
+    std::shared_ptr<const ZoneMap> inner_zones;   // inner 페이지별 키 범위 (없으면 nullptr)
+    size_t inner_zone_slot;        // inner_zones에서 조인 키의 슬롯
+    size_t inner_pool_frames;      // inner 페이지 버퍼 풀 프레임 수 (0이면 풀 없이 스캔)
+    ReplacementPolicy inner_pool_policy;   // inner 버퍼 풀 교체 정책 (기본: MRU)
     Statistics stats;
+    std::vector<Statistics> thread_stats;  // 작업자별 inner 읽기/출력 통계
 
     // 조인 수행 헬퍼 함수
     void performJoin();
 
+    // threads개 스레드가 나눠 가질 inner 버퍼 풀 프레임 합 (스레드마다 최소 1개, 풀이 없으면 0)
+    size_t innerPoolFrames(size_t threads) const;
+
+    // 스캔 방식에 맞는 입력 리더 생성
+    // (allow_prefetch가 false이면 미리 읽기 없이 페이지 단위로 읽는 리더)
+    std::unique_ptr<BlockSource> openScan(const std::string& file, ScanMethod method,
+                                          Statistics* read_stats, bool allow_prefetch = true);
+
     // 일반화된 조인 함수
-    void joinTables(TableReader& outer_reader,
-                    TableReader& inner_reader,
-                    TableWriter& writer,
+    void joinTables(BlockSource& outer_reader,
+                    BlockSource& inner_reader,
+                    BlockSink& writer,
                     BufferManager& buffer_mgr);
 
-    // 레코드에서 조인 키 값 추출
-    int_t getJoinKeyValue(const Record& rec, const std::string& table_type);
+    // 병렬 조인: outer 청크를 공유하고 inner 파일을 블록 구간으로 나눠 스레드별 스캔
+    void joinTablesParallel(BlockSource& outer_reader,
+                            BlockSink& writer,
+                            BufferManager& buffer_mgr);
+
+    // Outer 청크 키의 [min, max]와 겹치지 않는 inner 페이지를 건너뛰는 필터
+    // (inner 존 맵이 없으면 모든 페이지 읽기)
+    PageFilter chunkFilter(const std::vector<int_t>& outer_keys) const;
 
-    // 두 레코드를 병합하여 조인 결과 생성
-    Record mergeRecords(const Record& outer_rec, const Record& inner_rec);
+    // 블록의 레코드 뷰와 조인 키를 추출하여 배열 뒤에 추가
+    static void extractKeys(const Block* block, const Schema* schema, size_t key_col,
+                            std::vector<RecordView>& records, std::vector<int_t>& keys);
 
 public:
     BlockNestedLoopsJoin(const std::string& outer_file,
@@ -44,6 +126,40 @@ public:
                          size_t buf_size = 10,
                          size_t blk_size = DEFAULT_BLOCK_SIZE);
 
+    // 키 비교 커널 지정 (기본값은 실행 시 CPU 기능 감지 결과)
+    void setMatchKernel(MatchKernel kernel) { match_kernel = kernel; }
+
+    // 청크 매칭 방식 지정 (HASH: outer 청크 해시 인덱스로 inner 레코드당 1회 조회)
+    void setMatchMode(ChunkMatchMode mode) { match_mode = mode; }
+
+    // Inner 스캔 스레드 수 지정 (스레드마다 inner 버퍼 1개를 쓰므로 buffer_size - 1 이하로 제한)
+    void setThreads(size_t threads) { num_threads = threads > 0 ? threads : 1; }
+
+    // 미리 읽기 깊이 지정 (리더마다 I/O 스레드 1개와 depth개 블록 링 사용, 0이면 끔)
+    void setPrefetchDepth(size_t depth) { prefetch_depth = depth; }
+
+    // Outer / Inner 스캔 방식 지정 (MMAP: 매핑된 페이지를 복사 없이 참조)
+    void setScanMethods(ScanMethod outer, ScanMethod inner) {
+        outer_scan = outer;
+        inner_scan = inner;
+    }
+    void setMapOptions(const MapOptions& options) { map_options = options; }
+
+    // 출력 write-behind 풀 크기 지정 (백그라운드 스레드가 모아서 pwritev, 0이면 끔)
+    void setWriteBehind(size_t blocks) { write_behind_blocks = blocks; }
+
+    // inner 존 맵(.dat.zones) 사용 여부 (있으면 기본으로 사용)
+    void setZoneMaps(bool enabled) { use_zone_maps = enabled; }
+
+    // inner 페이지를 frames개 프레임의 버퍼 풀을 거쳐 읽음 (청크 사이에 남아 있는 페이지는
+    // 다시 읽지 않음, 병렬이면 스레드마다 나눠 가짐, inner 미리 읽기는 쓰지 않음).
+    // 프레임은 inner 버퍼를 대신해 buffer_size 안에서 잡으므로 outer 청크는 B - frames.
+    // 0이면 끔
+    void setInnerPool(size_t frames, ReplacementPolicy policy = ReplacementPolicy::MRU) {
+        inner_pool_frames = frames;
+        inner_pool_policy = policy;
+    }
+
     // 조인 실행
     void execute();
 
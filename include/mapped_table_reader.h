@@ -0,0 +1,74 @@
+#ifndef MAPPED_TABLE_READER_H
+#define MAPPED_TABLE_READER_H
+
+#include "common.h"
+#include "block.h"
+#include "table.h"
+#include <string>
+
+// 입력 스캔 방식: read 계열 시스템 호출로 블록에 복사 / mmap 영역을 직접 참조
+enum class ScanMethod {
+    READ,
+    MMAP
+};
+
+// mmap 접근 패턴 힌트 (madvise)
+enum class MapAdvice {
+    NORMAL,        // 힌트 없음
+    SEQUENTIAL,    // MADV_SEQUENTIAL: 공격적 미리 읽기, 지나간 페이지는 빨리 회수
+    WILLNEED       // MADV_WILLNEED: 파일 전체를 미리 페이지 캐시로
+};
+
+struct MapOptions {
+    MapAdvice advice;
+    bool populate;         // MAP_POPULATE: 매핑 시 페이지 테이블까지 미리 채움
+
+    MapOptions() : advice(MapAdvice::SEQUENTIAL), populate(false) {}
+};
+
+ScanMethod parseScanMethod(const std::string& name);
+MapAdvice parseMapAdvice(const std::string& name);
+
+/**
+ * ============================================================================
+ * 메모리 매핑 테이블 리더 (읽기 전용, 복사 없음)
+ * ============================================================================
+ *
+ * .dat 파일 전체를 읽기 전용으로 mmap하고, readBlock()은 호출자 블록을 매핑 안의
+ * 해당 페이지를 가리키는 뷰로 바꾼다 (Block::attach). read 복사, Block::clear의
+ * memset, 블록별 할당이 모두 없으므로 페이지 캐시에 올라온 파일을 반복 스캔하는
+ * BNLJ inner 스캔에 유리하다.
+ *
+ * 주의: 뷰 블록과 그 위의 RecordView는 리더가 살아 있는 동안만 유효하다.
+ */
+class MappedTableReader : public BlockSource {
+private:
+    std::string filename;
+    int fd;
+    const char* mapping;
+    size_t map_size;
+    size_t block_size;
+    size_t block_count;
+    size_t next_page;
+    Statistics* stats;
+    PageFilter filter;     // 순차 읽기에서 건너뛸 페이지
+
+    // 페이지 하나를 뷰로 연결하고 검증
+    void attachPage(Block* block, size_t page_no);
+
+public:
+    MappedTableReader(const std::string& fname, size_t blk_size = DEFAULT_BLOCK_SIZE,
+                      Statistics* st = nullptr, const MapOptions& options = MapOptions());
+    ~MappedTableReader();
+
+    MappedTableReader(const MappedTableReader&) = delete;
+    MappedTableReader& operator=(const MappedTableReader&) = delete;
+
+    bool readBlock(Block* block) override;
+    bool readBlockAt(size_t page_no, Block* block) override;
+    void reset() override;
+    size_t getBlockCount() const override { return block_count; }
+    void setPageFilter(const PageFilter& page_filter) override { filter = page_filter; }
+};
+
+#endif // MAPPED_TABLE_READER_H
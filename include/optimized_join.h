@@ -5,8 +5,10 @@
 #include "table.h"
 #include "buffer.h"
 #include "join.h"
+#include "flat_hash_table.h"
+#include "mapped_table_reader.h"
 #include <string>
-#include <unordered_map>
+#include <memory>
 #include <vector>
 
 /**
@@ -18,6 +20,32 @@
 // ============================================================================
 // Hash Join (일반화 버전)
 // ============================================================================
+
+// Hash Join 실행 방식
+enum class HashJoinMode {
+    IN_MEMORY,   // Build 테이블 전체를 해시 테이블에 로드 (기본)
+    GRACE,       // 두 입력을 디스크 파티션으로 나눈 뒤 파티션 쌍마다 메모리 조인
+    HYBRID,      // 예산이 허락하는 파티션은 메모리에 두고 나머지만 스필
+    RADIX        // 두 입력을 메모리에 올려 캐시 크기 단위로 radix 분할 후 파티션별 조인
+};
+
+// 최상위 파티션별 스필 통계 (Grace / Hybrid)
+struct PartitionSpillStats {
+    bool resident;           // Hybrid: 첫 패스에서 메모리에 남아 스필 없이 조인된 파티션
+    size_t build_records;
+    size_t probe_records;
+    size_t build_blocks;     // 임시 파일로 스필된 Build 블록 수 (resident면 0)
+    size_t probe_blocks;     // 임시 파일로 스필된 Probe 블록 수 (resident면 0)
+    size_t spill_reads;      // 이 파티션 조인 중 임시 파일 읽기 (재분할 포함)
+    size_t spill_writes;     // 이 파티션의 임시 파일 쓰기 (재분할 포함)
+
+    PartitionSpillStats() : resident(false), build_records(0), probe_records(0),
+                            build_blocks(0), probe_blocks(0),
+                            spill_reads(0), spill_writes(0) {}
+};
+
+class PartitionOutput;
+
 /**
  * Hash Join 구현 - 모든 테이블/키 조합 지원
  *
@@ -38,6 +66,35 @@
  * - Build 테이블이 메모리에 들어가야 함
  * - 해시 테이블 구축 오버헤드
  * - Equi-join만 지원
+ *
+ * Grace 모드 (메모리 예산 M, 블록 크기 P, 예산 내 블록 수 B = M / P):
+ * 1. Partition: 두 입력을 같은 키 해시로 F개 임시 파일에 분할 (F+1 블록 사용)
+ * 2. Join: 파티션 쌍 (R_i, S_i)마다 R_i로 해시 테이블을 만들고 S_i로 probe
+ * 3. R_i가 여전히 M을 넘으면 다른 해시 시드로 재귀 재분할,
+ *    같은 키만 남아 분할이 진행되지 않으면 R_i를 M 단위로 나눠 S_i 반복 스캔
+ *
+ * I/O 복잡도: 약 3(|R| + |S|) (읽기 → 파티션 쓰기 → 파티션 읽기), 재분할 단계마다 +2
+ * 메모리 요구: max(F+1 블록, 파티션 하나의 해시 테이블) ≤ M
+ *
+ * Hybrid 모드:
+ * Build 분할 중 모든 파티션을 해시 테이블에 두다가 예산을 넘으면 번호가 큰
+ * 파티션부터 임시 파일로 내보낸다. Probe 레코드 중 메모리에 남은 파티션에
+ * 속하는 것은 첫 패스에서 바로 조인되고, 나머지 파티션 쌍만 Grace처럼 처리한다.
+ * 메모리에 남은 Build 비율을 q라 하면 I/O ≈ (|R| + |S|) + 2(1 - q)(|R| + |S|)
+ *
+ * Radix 모드 (메모리 내 조인, I/O = |R| + |S|):
+ * Build 해시 테이블이 캐시보다 크면 probe마다 캐시 미스가 난다. 두 입력의
+ * (키, 행 번호)를 키 해시의 하위 비트로 1~2 패스 radix 분할하여 Build 파티션
+ * 하나의 해시 인덱스가 L2 캐시 절반에 들어가게 한 뒤, 파티션마다 build/probe 한다.
+ * 패스당 비트 수는 TLB 미스를 피하도록 제한하고, 전체 비트 수(fanout = 2^bits)는
+ * 실행 시 감지한 캐시 크기로 정하거나 setRadixBits로 지정한다.
+ *
+ * 병렬 실행 (in-memory 모드, 스레드 N개):
+ * 1. Build 블록을 모어셀 단위로 나눠 읽으며 키 해시로 파티션별 목록에 분배
+ * 2. 파티션마다 독립된 FlatHashTable을 스레드들이 나눠 구축 (잠금 없음)
+ * 3. Probe 파일을 모어셀 단위로 가져가 읽기 전용 테이블을 조회, 결과는 스레드별
+ *    출력 블록에 모았다가 가득 찰 때만 잠금을 잡고 공용 출력 파일에 기록
+ * 통계는 스레드별로 모은 뒤 마지막에 합산한다.
  */
 class HashJoin {
 private:
@@ -48,16 +105,125 @@ private:
     std::string probe_table_type;   // 테이블 타입
     std::string join_key;           // 조인 키 (partkey, suppkey 등)
     size_t block_size;
+    const Schema* build_schema;     // Build 테이블 행 형식
+    const Schema* probe_schema;     // Probe 테이블 행 형식
+    Schema output_schema;           // 조인 결과 행 형식 (build 컬럼 + probe 컬럼)
+    size_t build_key_col;           // Build 스키마에서 조인 키 컬럼 인덱스
+    size_t probe_key_col;           // Probe 스키마에서 조인 키 컬럼 인덱스
     Statistics stats;
+    Statistics spill_stats;         // 임시 파티션 파일 I/O (execute 끝에 stats로 합산)
+
+    HashJoinMode mode;
+    size_t memory_limit;            // 해시 테이블 메모리 예산 (바이트, Grace/Hybrid 모드)
+
+    // 해시 테이블: JOIN_KEY → Build 레코드 바이트 (개방 주소법 + arena)
+    FlatHashTable hash_table;
+    size_t peak_hash_memory;        // 실행 중 최대 해시 테이블 메모리
+
+    // 실행 요약
+    size_t build_table_blocks;      // |R|
+    size_t probe_table_blocks;      // |S|
+    size_t build_records;
+    size_t probe_records;
+    size_t partitions_created;      // 생성한 파티션 파일 쌍 수 (재분할 포함)
+    size_t max_depth;               // 최대 재분할 깊이 (0 = 최초 분할만)
+    size_t chunked_partitions;      // 분할로 줄일 수 없어 청크 단위로 조인한 파티션 수
+    size_t max_fanout;              // 한 번의 분할에서 사용한 최대 파티션 수
+    std::vector<PartitionSpillStats> partition_stats;   // 최상위 파티션별 통계
+
+    // Radix 모드
+    size_t radix_bits;              // 전체 radix 비트 수 (0 = 캐시 크기로 자동 결정)
+    size_t cache_size;              // 파티션 크기 목표로 쓰는 캐시 크기 (바이트)
+    size_t radix_passes;            // 실제 사용한 분할 패스 수
+    size_t radix_fanout;            // 실제 사용한 파티션 수
+    double partition_time;          // 분할 단계 시간 (초)
+    double join_time;               // 파티션별 build/probe 시간 (초)
+
+    // 병렬 실행
+    size_t num_threads;             // 작업자 스레드 수 (1 = 단일 스레드)
+    std::vector<Statistics> thread_stats;   // 스레드별 통계 (execute 끝에 stats로 합산)
+    size_t prefetch_depth;          // 순차 스캔 리더의 미리 읽기 블록 수 (0 = 동기 읽기)
+    ScanMethod scan_method;         // 순차 스캔 방식 (MMAP이면 매핑 페이지 뷰)
+    MapOptions map_options;
+    size_t write_behind_blocks;     // write-behind 출력 풀 블록 수 (0 = 동기 기록)
+    size_t output_write_calls;      // write-behind pwritev 호출 수
+    double output_stall_time;       // 빈 출력 블록을 기다린 시간 (초)
+
+    // 순차 스캔용 입력 리더 (mmap 뷰, 또는 prefetch_depth > 0이면 백그라운드 I/O 스레드로 미리 읽기)
+    std::unique_ptr<BlockSource> openReader(const std::string& file, Statistics* read_stats);
 
-    // 해시 테이블: JOIN_KEY → Record 리스트
-    std::unordered_map<int_t, std::vector<Record>> hash_table;
+    // 해시 테이블 비우기 / 레코드 하나 추가
+    void clearHashTable();
+    void insertBuildRecord(int_t key, const RecordView& record);
 
-    void buildHashTable();
-    void probeAndJoin(TableWriter& writer);
+    // reader에서 최대 max_blocks 블록(0 = 전부)을 읽어 해시 테이블에 추가, 읽은 블록 수 반환
+    // expected_records가 0이 아니면 (테이블 메타데이터) 첫 블록 추정 대신 그 크기로 미리 할당
+    size_t buildHashTable(BlockSource& reader, size_t max_blocks,
+                          size_t expected_records = 0, size_t expected_bytes = 0);
 
-    // 레코드에서 조인 키 값 추출
-    int_t getJoinKeyValue(const Record& rec, const std::string& table_type);
+    // reader 전체를 해시 테이블로 probe, 결과는 output_block에 모아 writer로 기록
+    void probeAndJoin(BlockSource& reader, BlockSink& writer, Block& output_block);
+
+    // key와 매칭되는 모든 Build 레코드를 probe_record와 조인
+    void probeKey(int_t key, const RecordView& probe_record,
+                  BlockSink& writer, Block& output_block);
+
+    // 조인 결과 하나를 출력 블록에 기록 (가득 차면 플러시)
+    void emitJoined(const RecordView& build_record, const RecordView& probe_record,
+                    BlockSink& writer, Block& output_block);
+
+    // --- Grace 모드 ---
+    // blocks 블록짜리 Build 입력의 해시 테이블이 memory_limit 안에 들어가는지
+    bool fitsInMemory(size_t blocks) const;
+
+    // blocks 블록짜리 Build 입력을 나눌 파티션 수
+    size_t chooseFanout(size_t blocks) const;
+
+    // 예산 안에서 동시에 열 수 있는 최대 파티션 수 (파티션마다 버퍼 블록 + io_uring 창)
+    size_t maxPartitionFanout() const;
+
+    // 파티션 임시 파일 이름 (output_file.part.<side>.<경로>.tmp)
+    std::vector<std::string> partitionFileNames(const std::string& side, const std::string& path,
+                                                size_t fanout) const;
+    static std::string partitionId(const std::string& path, size_t p);
+
+    // 입력 파일을 level 단계 키 해시로 parts에 분할
+    void partitionFile(const std::string& input_file, Statistics* read_stats,
+                       const Schema* schema, size_t key_col, size_t level,
+                       PartitionOutput& parts);
+
+    // Build/Probe 입력 쌍을 메모리 예산 안에서 조인 (필요하면 재귀 분할)
+    void graceJoin(const std::string& build_file, const std::string& probe_file,
+                   size_t build_blocks, size_t level, const std::string& path,
+                   Statistics* read_stats, BlockSink& writer, Block& output_block);
+
+    // 분할된 파티션 쌍 중 resident가 아닌 것을 조인 (최상위면 파티션별 통계 기록)
+    void joinSpilledPartitions(const PartitionOutput& build_parts,
+                               const PartitionOutput& probe_parts,
+                               const std::vector<bool>& resident,
+                               size_t parent_blocks, size_t level, const std::string& path,
+                               BlockSink& writer, Block& output_block);
+
+    // Build 입력을 메모리 예산 단위 청크로 나눠 청크마다 Probe 입력 전체 스캔
+    void chunkedJoin(const std::string& build_file, const std::string& probe_file,
+                     Statistics* read_stats, BlockSink& writer, Block& output_block);
+
+    // --- Hybrid 모드 ---
+    void hybridJoin(BlockSink& writer, Block& output_block);
+
+    // 해시 테이블에 있는 파티션 p의 레코드를 모두 임시 파일로 옮김
+    void spillResidentPartition(size_t p, size_t fanout, PartitionOutput& build_parts);
+
+    // --- 병렬 in-memory 모드 ---
+    void parallelJoin(BlockSink& writer);
+
+    // --- Radix 모드 ---
+    void radixJoin(BlockSink& writer, Block& output_block);
+
+    // build_tuples개 Build 튜플에 대한 패스별 radix 비트 수
+    void chooseRadixBits(size_t build_tuples, size_t& pass1_bits, size_t& pass2_bits) const;
+
+    void printStatistics() const;
 
 public:
     HashJoin(const std::string& build_file,
@@ -68,8 +234,19 @@ public:
              const std::string& join_key_name,
              size_t blk_size = DEFAULT_BLOCK_SIZE);
 
+    void setMode(HashJoinMode m) { mode = m; }
+    void setMemoryLimit(size_t bytes) { memory_limit = bytes; }
+    void setRadixBits(size_t bits) { radix_bits = bits; }
+    void setCacheSize(size_t bytes) { cache_size = bytes; }
+    void setThreads(size_t threads) { num_threads = threads > 0 ? threads : 1; }
+    void setPrefetchDepth(size_t depth) { prefetch_depth = depth; }
+    void setScanMethod(ScanMethod method) { scan_method = method; }
+    void setMapOptions(const MapOptions& options) { map_options = options; }
+    void setWriteBehind(size_t blocks) { write_behind_blocks = blocks; }
+
     void execute();
     const Statistics& getStatistics() const { return stats; }
+    const std::vector<PartitionSpillStats>& getPartitionStats() const { return partition_stats; }
 };
 
 // ============================================================================
@@ -0,0 +1,53 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * 작업자 스레드 실행 헬퍼
+ *
+ * 조인 단계 하나를 N개 스레드로 나눠 실행할 때 사용한다. 스레드 간 작업 분배는
+ * 호출자가 (보통 std::atomic 카운터로 모어셀/파티션 번호를 나눠 주는 방식) 정한다.
+ */
+
+// 요청한 스레드 수 (0이면 하드웨어 스레드 수, 알 수 없으면 1)
+inline size_t resolveThreadCount(size_t requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// fn(thread_id)를 thread_count개 스레드에서 실행하고 모두 끝날 때까지 대기
+// 작업자에서 예외가 나면 모든 스레드가 끝난 뒤 첫 예외를 호출자에게 다시 던짐
+template <typename Fn>
+void runParallel(size_t thread_count, Fn fn) {
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&fn, &errors, t]() {
+            try {
+                fn(t);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif // PARALLEL_H
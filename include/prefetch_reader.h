@@ -0,0 +1,111 @@
+#ifndef PREFETCH_READER_H
+#define PREFETCH_READER_H
+
+#include "common.h"
+#include "block.h"
+#include "table.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 미리 읽기 테이블 리더
+ * ============================================================================
+ *
+ * 백그라운드 I/O 스레드가 페이지를 순서대로 읽어 depth개 블록 링에 채우고,
+ * 소비자(조인 스레드)는 readBlock()에서 채워진 블록을 꺼내 간다.
+ * depth = 2면 이중, 3이면 삼중 버퍼링이다.
+ *
+ * 링은 생산자 1개 / 소비자 1개 전용(SPSC)이며 락 없이 두 카운터로 관리한다:
+ *   head : 생산자가 채운 블록 수 (생산자만 증가)
+ *   tail : 소비자가 꺼낸 블록 수 (소비자만 증가)
+ *   head - tail = 링에 대기 중인 블록 수 (0 ~ depth)
+ *
+ * readBlock()은 블록 내용을 복사하지 않고 호출자 블록과 링 슬롯의 버퍼를
+ * 맞바꾼다. 호출자가 넘긴 이전 버퍼는 링으로 돌아가 다음 페이지를 읽는 데 쓰인다.
+ * 링이 비어 있어 기다린 시간은 Statistics::io_stall_time에 누적된다.
+ *
+ * 링이 가득 차거나(생산자) 비어 있으면(소비자) SPIN_WAITS번만 yield하며 기다리고,
+ * 그래도 안 되면 condition variable에서 잠든다. CPU를 쓰는 조인보다 I/O 스레드가
+ * 대개 앞서 있으므로, 계속 돌면 조인 내내 코어 하나를 빼앗게 된다.
+ * 상대편은 카운터를 갱신한 뒤 *_waiting이 켜져 있을 때만 잠금을 잡고 깨운다.
+ */
+class PrefetchReader : public BlockSource {
+private:
+    TableReader reader;            // I/O 스레드 전용 (통계 없음)
+    size_t block_size;
+    size_t depth;
+    Statistics* stats;
+
+    std::vector<Block> ring;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<bool> done;        // 생산자가 구간 끝에 도달 (또는 오류)
+    std::atomic<bool> stop;        // 소비자가 생산자 중단 요청
+    std::exception_ptr error;      // 생산자 오류 (done 이후 소비자가 다시 던짐)
+
+    // 짧게 돈 뒤에도 기다려야 할 때 잠드는 곳
+    std::mutex wait_mutex;
+    std::condition_variable not_full;          // 생산자: 빈 슬롯 / stop
+    std::condition_variable not_empty;         // 소비자: 채워진 슬롯 / done
+    std::atomic<bool> producer_waiting;
+    std::atomic<bool> consumer_waiting;
+    std::thread io_thread;
+
+    // 건너뛸 페이지: 새 필터는 next_filter에 두었다가 restart()에서 I/O 스레드가
+    // 멈춘 동안 filter로 교체 (I/O 스레드는 filter만 읽음)
+    PageFilter filter;
+    PageFilter next_filter;
+    size_t skipped;                // I/O 스레드가 건너뛴 페이지 수 (done 이후 / 중단 후 합산)
+
+    // I/O 스레드 본체: [begin, end) 페이지를 링에 채움
+    void produce(size_t begin, size_t end);
+
+    // 상대편이 잠들어 있으면 깨움 (카운터 / 플래그를 갱신한 뒤 호출)
+    void wake(std::atomic<bool>& waiting, std::condition_variable& cv);
+
+    // 실행 중인 I/O 스레드 중단 및 대기
+    void stopThread();
+
+    // I/O 스레드가 건너뛴 페이지 수를 통계에 반영 (I/O 스레드가 끝난 뒤 호출)
+    void collectSkipped();
+
+public:
+    static const size_t DEFAULT_DEPTH = 4;
+    static const size_t SPIN_WAITS = 64;    // 잠들기 전 yield 횟수
+
+    PrefetchReader(const std::string& fname, size_t blk_size = DEFAULT_BLOCK_SIZE,
+                   size_t prefetch_depth = DEFAULT_DEPTH, Statistics* st = nullptr);
+    ~PrefetchReader();
+
+    PrefetchReader(const PrefetchReader&) = delete;
+    PrefetchReader& operator=(const PrefetchReader&) = delete;
+
+    // 다음 블록 (block과 링 슬롯의 버퍼를 교환)
+    bool readBlock(Block* block) override;
+
+    // page_no부터 다시 미리 읽기를 시작하고 첫 블록 반환
+    bool readBlockAt(size_t page_no, Block* block) override;
+
+    // 처음부터 다시 미리 읽기
+    void reset() override;
+
+    // [begin, end) 페이지 구간만 미리 읽기 시작
+    void restart(size_t begin, size_t end);
+
+    size_t getBlockCount() const override { return reader.getBlockCount(); }
+
+    // 다음 reset() / readBlockAt() / restart()부터 적용
+    void setPageFilter(const PageFilter& page_filter) override { next_filter = page_filter; }
+    size_t getDepth() const { return depth; }
+
+    // 링이 차지하는 메모리 (바이트)
+    size_t getMemoryUsage() const { return depth * block_size; }
+};
+
+#endif // PREFETCH_READER_H
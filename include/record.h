@@ -3,54 +3,161 @@
 
 #include "common.h"
 #include "block.h"
+#include "schema.h"
 #include <string>
 #include <vector>
 #include <cstring>
 
-// 가변 길이 레코드 형식
-// [record_size(4 bytes)][field1_len(2 bytes)][field1_data][field2_len][field2_data]...
+// 스키마 기반 바이너리 레코드 형식 (schema.h 참고)
+// [고정 영역: INT/DECIMAL][STRING 끝 오프셋 테이블 (uint16)][문자열 데이터]
+// 레코드 길이는 페이지의 슬롯 배열에 저장됨 (block.h 참고)
+
+class Record;
+
+// 문자열 필드 참조 (블록 메모리를 가리키며 소유하지 않음)
+struct StringRef {
+    const char* data;
+    size_t size;
+
+    std::string str() const { return std::string(data, size); }
+    bool operator==(const StringRef& other) const {
+        return size == other.size && std::memcmp(data, other.data, size) == 0;
+    }
+};
+
+/**
+ * RecordView - 블록 메모리 위의 인코딩된 행을 가리키는 비소유 뷰
+ *
+ * 필드 접근은 스키마의 고정 오프셋/오프셋 테이블만 따라가므로 할당이 없다.
+ * 뷰는 원본 블록이 재사용되기 전까지만 유효하며, 그 이후에도 필요한 레코드는
+ * materialize()로 소유 Record를 만들어야 한다.
+ * 타입 검사를 하지 않으므로 호출자가 컬럼 타입을 보장해야 함 (핫 루프용).
+ */
+class RecordView {
+private:
+    const Schema* schema;
+    const char* data;
+    size_t size;
+
+public:
+    RecordView() : schema(nullptr), data(nullptr), size(0) {}
+    RecordView(const Schema* s, const char* d, size_t sz) : schema(s), data(d), size(sz) {}
+
+    const Schema* getSchema() const { return schema; }
+    const char* getData() const { return data; }
+    size_t getSize() const { return size; }
+    size_t getFieldCount() const { return schema->getColumnCount(); }
+
+    int_t getInt(size_t idx) const {
+        return static_cast<int_t>(loadLE32(data + schema->getColumn(idx).position));
+    }
+
+    decimal_t getDecimal(size_t idx) const {
+        uint32_t bits = loadLE32(data + schema->getColumn(idx).position);
+        decimal_t value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    StringRef getString(size_t idx) const {
+        size_t k = schema->getColumn(idx).position;
+        const char* offsets = data + schema->getFixedSize();
+        size_t begin = k == 0 ? schema->getHeaderSize()
+                              : loadLE16(offsets + (k - 1) * sizeof(uint16_t));
+        size_t end = loadLE16(offsets + k * sizeof(uint16_t));
+        StringRef ref = {data + begin, end - begin};
+        return ref;
+    }
+
+    // 오프셋 테이블이 레코드 범위 안에 있는지 검사
+    bool isValid() const;
+
+    // 소유 Record로 복사
+    Record materialize() const;
+
+    // 두 뷰를 이어 붙인 결과 행의 크기 / 인코딩 (result_schema = left + right)
+    static size_t concatSize(const Schema* result_schema,
+                             const RecordView& left, const RecordView& right);
+    static void concatInto(char* out, const Schema* result_schema,
+                           const RecordView& left, const RecordView& right);
+};
 
 class Record {
 private:
-    std::vector<std::string> fields;
+    const Schema* schema;
+    std::vector<char> data;   // 인코딩된 행
 
 public:
-    Record() {}
-    Record(const std::vector<std::string>& f) : fields(f) {}
+    Record() : schema(nullptr) {}
+    Record(const Schema* s, std::vector<char>&& bytes) : schema(s), data(std::move(bytes)) {}
+
+    const Schema* getSchema() const { return schema; }
+
+    // 인코딩된 행에 대한 뷰 (Record가 살아있는 동안 유효)
+    RecordView view() const { return RecordView(schema, data.data(), data.size()); }
 
-    // 필드 추가
-    void addField(const std::string& field) { fields.push_back(field); }
+    // 필드 접근 (O(1), 문자열 파싱 없음, 타입 검사 포함)
+    size_t getFieldCount() const { return schema ? schema->getColumnCount() : 0; }
+    int_t getInt(size_t idx) const;
+    decimal_t getDecimal(size_t idx) const;
+    std::string getString(size_t idx) const;
 
-    // 필드 접근
-    const std::string& getField(size_t idx) const { return fields[idx]; }
-    size_t getFieldCount() const { return fields.size(); }
-    const std::vector<std::string>& getFields() const { return fields; }
+    // 표시용 문자열 변환
+    std::string getFieldAsString(size_t idx) const;
 
-    // 레코드를 바이트 배열로 직렬화
-    std::vector<char> serialize() const;
+    // 레코드를 바이트 배열로 직렬화 (이미 인코딩된 형태)
+    const std::vector<char>& serialize() const { return data; }
 
-    // 바이트 배열에서 레코드 역직렬화
-    static Record deserialize(const char* data, size_t& offset);
+    // 바이트 배열에서 레코드 역직렬화 (오프셋 테이블 검증 포함)
+    static Record deserialize(const Schema* schema, const char* data, size_t size);
 
     // 레코드의 직렬화된 크기 계산
-    size_t getSerializedSize() const;
+    size_t getSerializedSize() const { return data.size(); }
+
+    // 두 레코드를 이어 붙여 조인 결과 레코드 생성 (result_schema = left + right)
+    static Record concat(const Schema* result_schema, const Record& left, const Record& right);
 };
 
-// 레코드 리더 클래스 - 블록에서 레코드 읽기
+// 레코드 빌더 - 필드 값을 설정한 뒤 인코딩된 Record 생성
+class RecordBuilder {
+private:
+    const Schema* schema;
+    std::vector<char> fixed;              // 고정 영역
+    std::vector<std::string> strings;     // STRING 필드 값
+
+    const Column& checkColumn(size_t idx, FieldType type) const;
+
+public:
+    explicit RecordBuilder(const Schema* s);
+
+    void setInt(size_t idx, int_t value);
+    void setDecimal(size_t idx, decimal_t value);
+    void setString(size_t idx, const std::string& value);
+
+    Record build() const;
+};
+
+// 레코드 리더 클래스 - 블록의 슬롯 배열을 따라 레코드 읽기
+// 반환되는 RecordView는 블록 버퍼를 직접 가리킴 (복사 없음)
 class RecordReader {
 private:
     const Block* block;
-    size_t current_offset;
+    const Schema* schema;
+    size_t current_slot;
 
 public:
-    RecordReader(const Block* blk) : block(blk), current_offset(0) {}
+    RecordReader(const Block* blk, const Schema* s)
+        : block(blk), schema(s), current_slot(0) {}
 
     // 다음 레코드 읽기
     bool hasNext() const;
-    Record readNext();
+    RecordView readNext();
+
+    // 특정 슬롯의 레코드 읽기
+    RecordView readAt(size_t slot_no) const;
 
     // 리더 초기화
-    void reset() { current_offset = 0; }
+    void reset() { current_slot = 0; }
 };
 
 // 레코드 라이터 클래스 - 블록에 레코드 쓰기
@@ -62,7 +169,12 @@ public:
     RecordWriter(Block* blk) : block(blk) {}
 
     // 레코드 쓰기
-    bool writeRecord(const Record& record);
+    bool writeRecord(const Record& record) { return writeRecord(record.view()); }
+    bool writeRecord(const RecordView& record);
+
+    // 두 레코드를 이어 붙여 블록에 직접 인코딩 (중간 Record 생성 없음)
+    bool writeJoined(const Schema* result_schema,
+                     const RecordView& left, const RecordView& right);
 };
 
 #endif // RECORD_H
@@ -0,0 +1,103 @@
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include "common.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+// 필드 타입
+enum class FieldType : uint8_t {
+    INT = 0,       // int_t, 4 bytes little-endian
+    DECIMAL = 1,   // decimal_t (IEEE float), 4 bytes little-endian
+    STRING = 2     // 가변 길이 문자열
+};
+
+// 컬럼 정의
+struct Column {
+    std::string name;
+    FieldType type;
+    uint16_t position;   // INT/DECIMAL: 고정 영역 내 바이트 오프셋
+                         // STRING: 가변 필드 번호 (오프셋 테이블 인덱스)
+};
+
+/**
+ * 테이블 스키마 - 타입이 있는 바이너리 행 형식을 정의
+ *
+ * 행 레이아웃:
+ *   [고정 영역: INT/DECIMAL 필드, 각 4 bytes, 컬럼 순서대로]
+ *   [오프셋 테이블: STRING 필드마다 uint16 끝 오프셋 (레코드 시작 기준)]
+ *   [문자열 데이터]
+ *
+ * 숫자 필드는 고정 오프셋에서 바로 읽고, k번째 문자열은
+ * [k == 0 ? getHeaderSize() : end[k-1], end[k]) 구간이므로 모든 필드 접근이 O(1).
+ */
+class Schema {
+private:
+    std::string table_type;
+    std::vector<Column> columns;
+    size_t fixed_size;   // 고정 영역 크기 (바이트)
+    size_t var_count;    // STRING 필드 개수
+
+public:
+    Schema() : fixed_size(0), var_count(0) {}
+    Schema(const std::string& type,
+           const std::vector<std::pair<std::string, FieldType>>& cols);
+
+    // TPC-H 테이블 타입으로 스키마 조회 (알 수 없는 타입이면 예외)
+    static const Schema& forTable(const std::string& table_type);
+
+    // 조인 결과용 스키마 (left 컬럼 뒤에 right 컬럼)
+    static Schema concat(const Schema& left, const Schema& right);
+
+    const std::string& getTableType() const { return table_type; }
+    size_t getColumnCount() const { return columns.size(); }
+    const Column& getColumn(size_t idx) const { return columns[idx]; }
+
+    // 컬럼 이름으로 인덱스 찾기 (없으면 -1)
+    int findColumn(const std::string& name) const;
+
+    // 조인 키 컬럼 인덱스 (INT 컬럼이 아니거나 없으면 예외)
+    size_t getKeyColumn(const std::string& name) const;
+
+    size_t getFixedSize() const { return fixed_size; }
+    size_t getVarCount() const { return var_count; }
+    size_t getHeaderSize() const { return fixed_size + var_count * sizeof(uint16_t); }
+};
+
+// ============================================================================
+// 리틀 엔디언 인코딩 헬퍼
+// ============================================================================
+inline uint32_t loadLE32(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+inline void storeLE32(char* p, uint32_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline uint16_t loadLE16(const char* p) {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap16(v);
+#endif
+    return v;
+}
+
+inline void storeLE16(char* p, uint16_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap16(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+}
+
+#endif // SCHEMA_H
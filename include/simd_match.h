@@ -0,0 +1,71 @@
+#ifndef SIMD_MATCH_H
+#define SIMD_MATCH_H
+
+#include "common.h"
+#include <string>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 조인 키 동등 비교 커널 (BNLJ 내부 루프용)
+ * ============================================================================
+ *
+ * Outer 청크의 키가 연속된 int_t 배열에 있으므로, 내부 루프는
+ * "outer_keys[i] == k 인 모든 i 찾기"가 된다. 이를 SIMD로 한 번에
+ * 8개(AVX2) 또는 4개(SSE2)씩 비교하고, 매칭된 (outer, inner) 인덱스 쌍을
+ * 선택 벡터에 기록한다. 커널은 실행 시 CPU 기능을 확인하여 선택하며,
+ * x86이 아니거나 지원되지 않으면 스칼라 코드로 대체된다.
+ */
+
+enum class MatchKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// 선택 벡터: 매칭된 (outer 인덱스, inner 인덱스) 쌍
+struct SelectionVector {
+    std::vector<uint32_t> outer_idx;
+    std::vector<uint32_t> inner_idx;
+
+    void clear() {
+        outer_idx.clear();
+        inner_idx.clear();
+    }
+    size_t size() const { return outer_idx.size(); }
+};
+
+class KeyMatcher {
+private:
+    typedef size_t (*MatchFn)(const int_t* keys, size_t n, int_t probe, uint32_t* out);
+
+    MatchKernel kernel;
+    MatchFn match_fn;
+    std::vector<uint32_t> scratch;   // 키 하나에 대한 매칭 인덱스 임시 버퍼
+
+public:
+    explicit KeyMatcher(MatchKernel k = detectKernel());
+
+    // 이 CPU에서 사용할 수 있는 가장 넓은 커널
+    static MatchKernel detectKernel();
+
+    // 이름으로 커널 선택 ("auto", "avx2", "sse2", "scalar")
+    // CPU가 지원하지 않는 커널을 요청하면 예외
+    static MatchKernel parseKernel(const std::string& name);
+    static const char* kernelName(MatchKernel k);
+
+    MatchKernel getKernel() const { return kernel; }
+
+    // keys[0..n)에서 probe와 같은 위치를 out에 기록하고 개수 반환
+    // (out은 최소 n개 공간 필요)
+    size_t match(const int_t* keys, size_t n, int_t probe, uint32_t* out) const {
+        return match_fn(keys, n, probe, out);
+    }
+
+    // 각 inner 키에 대해 outer 키 배열 전체를 스캔하여 매칭 쌍을 sel에 추가
+    void matchBlock(const int_t* outer_keys, size_t outer_n,
+                    const int_t* inner_keys, size_t inner_n,
+                    SelectionVector& sel);
+};
+
+#endif // SIMD_MATCH_H
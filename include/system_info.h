@@ -0,0 +1,16 @@
+#ifndef SYSTEM_INFO_H
+#define SYSTEM_INFO_H
+
+#include <cstddef>
+
+/**
+ * 실행 중인 시스템의 하드웨어 정보 조회
+ *
+ * 조인 파라미터(파티션 수 등)를 고정값 대신 실제 캐시 크기에 맞추기 위해 사용한다.
+ * sysconf가 값을 주지 않으면 /sys/devices/system/cpu/cpu0/cache를 읽는다.
+ */
+
+// level 단계 데이터(또는 통합) 캐시 크기 (바이트, 알 수 없으면 0)
+size_t detectCacheSize(int level);
+
+#endif // SYSTEM_INFO_H
@@ -4,9 +4,12 @@
 #include "common.h"
 #include "record.h"
 #include "block.h"
+#include "io_backend.h"
+#include "table_metadata.h"
 #include <string>
 #include <vector>
 #include <fstream>
+#include <memory>
 
 // TPC-H PART 테이블 스키마
 struct PartRecord {
@@ -157,51 +160,158 @@ struct JoinResultRecord {
     Record toRecord() const;
 };
 
+// 블록 단위 순차 입력 (TableReader, PrefetchReader, MappedTableReader 공통 인터페이스)
+class BlockSource {
+public:
+    virtual ~BlockSource() {}
+
+    // 다음 블록 읽기 (끝이면 false)
+    virtual bool readBlock(Block* block) = 0;
+
+    // 지정한 페이지 읽기, 이후 순차 읽기는 다음 페이지부터 이어짐
+    virtual bool readBlockAt(size_t page_no, Block* block) = 0;
+
+    // 처음부터 다시 읽기
+    virtual void reset() = 0;
+
+    // 전체 페이지 수
+    virtual size_t getBlockCount() const = 0;
+
+    // 이후 순차 읽기(readBlock)에서 filter.skip(p)인 페이지를 건너뜀 (다음 reset() /
+    // readBlockAt()부터 적용). 건너뛰기를 지원하지 않는 리더는 무시하므로 호출자는
+    // 걸러졌어야 할 페이지를 받아도 올바르게 처리해야 함
+    virtual void setPageFilter(const PageFilter& filter) { (void)filter; }
+};
+
 // 테이블 리더 클래스
-class TableReader {
+// .dat 파일은 block_size 바이트 고정 크기 페이지의 연속 (block.h 참고)
+// I/O 방식은 IoOptions로 정함 (기본값은 getDefaultIoOptions(), io_backend.h 참고)
+class TableReader : public BlockSource {
 private:
     std::string filename;
-    std::ifstream file;
+    std::ifstream file;    // STREAM 백엔드
+    int fd;                // PREAD / URING 백엔드 (-1이면 사용 안 함)
+    IoOptions io;          // 실제 사용하는 I/O 설정
     size_t block_size;
+    size_t block_count;    // 파일의 전체 페이지 수
+    size_t next_page;      // 순차 읽기에서 다음에 읽을 페이지 번호
     Statistics* stats;
+    PageFilter filter;     // 순차 읽기에서 건너뛸 페이지
+
+    // URING 순차 읽기 창: 페이지 p의 읽기는 window[p % queue_depth]로 진행
+    std::unique_ptr<IoUring> ring;
+    std::vector<Block> window;
+    std::vector<int> window_result;  // 완료된 읽기 바이트 수 / -errno (진행 중이면 PENDING)
+    size_t submitted_end;            // 읽기를 제출한 마지막 페이지 + 1
+    size_t inflight;                 // 완료를 아직 받지 않은 요청 수
+
+    // 페이지 하나를 block에 읽기 (STREAM은 현재 파일 위치에서)
+    void fetchPage(Block* block, size_t page_no);
+
+    // 읽은 페이지 검증 및 통계 기록
+    void checkPage(const Block* block, size_t page_no);
+
+    // 페이지 하나 읽기 및 검증
+    bool readPage(Block* block, size_t page_no);
+
+    // 순차 읽기 위치를 filter가 건너뛰라는 페이지 뒤로 이동
+    void skipFilteredPages();
+
+    // URING: 창이 찰 때까지 다음 페이지 읽기 제출 / 완료 수거 / 진행 중인 읽기 모두 대기
+    void fillWindow();
+    void reapCompletions(bool wait);
+    void drainWindow();
 
 public:
     TableReader(const std::string& fname, size_t blk_size = DEFAULT_BLOCK_SIZE,
                 Statistics* st = nullptr);
+    TableReader(const std::string& fname, size_t blk_size, Statistics* st,
+                const IoOptions& options);
     ~TableReader();
 
     // 다음 블록 읽기
-    bool readBlock(Block* block);
+    bool readBlock(Block* block) override;
+
+    // 지정한 페이지를 한 번의 위치 지정 읽기로 가져오기
+    bool readBlockAt(size_t page_no, Block* block) override;
+
+    // RID로 레코드 하나 가져오기 (scratch 블록에 해당 페이지를 읽음)
+    Record readRecord(const RecordId& rid, const Schema* schema, Block* scratch);
 
     // 파일 처음으로 되돌리기
-    void reset();
+    void reset() override;
+
+    // 파일의 페이지 수
+    size_t getBlockCount() const override { return block_count; }
+
+    // 순차 읽기에서 건너뛸 페이지 (URING은 진행 중인 읽기를 모두 끝낸 뒤 적용)
+    void setPageFilter(const PageFilter& page_filter) override;
+
+    // 실제 사용하는 I/O 설정 (대체 후)
+    const IoOptions& getIoOptions() const { return io; }
 
     // 파일이 열려있는지 확인
-    bool isOpen() const { return file.is_open(); }
+    bool isOpen() const { return io.backend == IoBackend::STREAM ? file.is_open() : fd >= 0; }
+};
+
+// 블록 단위 출력 (TableWriter, WriteBehindWriter 공통 인터페이스)
+class BlockSink {
+public:
+    virtual ~BlockSink() {}
+
+    // 블록 내용을 기록 (블록은 호출자가 계속 소유)
+    virtual bool writeBlock(const Block* block) = 0;
+
+    // 가득 찬 출력 블록을 넘기고 빈 블록 상태로 돌려받음
+    // 기본 동작은 기록 후 clear(), write-behind 구현은 빈 풀 블록과 버퍼를 교환
+    virtual void flushBlock(Block* block) {
+        writeBlock(block);
+        block->clear();
+    }
 };
 
 // 테이블 라이터 클래스
-class TableWriter {
+// URING 백엔드는 블록을 창 버퍼로 복사해 비동기로 쓰고, close()/소멸 시 모두 완료를 기다림
+class TableWriter : public BlockSink {
 private:
     std::string filename;
-    std::ofstream file;
+    std::ofstream file;    // STREAM 백엔드
+    int fd;                // PREAD / URING 백엔드
+    IoOptions io;
+    size_t write_offset;   // 다음 블록을 쓸 파일 오프셋
     Statistics* stats;
 
+    std::unique_ptr<IoUring> ring;
+    std::vector<Block> window;       // 쓰기 중인 블록 사본 (첫 쓰기 때 할당)
+    std::vector<size_t> free_slots;
+    size_t inflight;
+
+    // URING: 완료된 쓰기를 수거하여 슬롯 반환 (wait이면 최소 1개 대기)
+    void reapCompletions(bool wait);
+
 public:
     TableWriter(const std::string& fname, Statistics* st = nullptr);
+    TableWriter(const std::string& fname, Statistics* st, const IoOptions& options);
     ~TableWriter();
 
     // 블록 쓰기
-    bool writeBlock(const Block* block);
+    bool writeBlock(const Block* block) override;
+
+    // 진행 중인 쓰기를 모두 끝내고 파일 닫기 (오류는 예외로 보고)
+    void close();
 
     // 파일이 열려있는지 확인
-    bool isOpen() const { return file.is_open(); }
+    bool isOpen() const { return io.backend == IoBackend::STREAM ? file.is_open() : fd >= 0; }
 };
 
 // TBL 파일(파이프 구분 텍스트)을 블록 기반 .dat 파일로 변환
+// num_threads개 스레드가 줄 경계로 나눈 청크를 파싱하며, preserve_order이면
+// 출력이 단일 스레드 변환과 바이트 단위로 같다
 void convertTBLToBlocks(const std::string& tbl_file,
                         const std::string& block_file,
                         const std::string& table_type,
-                        size_t block_size = DEFAULT_BLOCK_SIZE);
+                        size_t block_size = DEFAULT_BLOCK_SIZE,
+                        size_t num_threads = 1,
+                        bool preserve_order = true);
 
 #endif // TABLE_H
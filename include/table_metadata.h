@@ -0,0 +1,155 @@
+#ifndef TABLE_METADATA_H
+#define TABLE_METADATA_H
+
+#include "common.h"
+#include "block.h"
+#include "schema.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * ============================================================================
+ * 테이블 메타데이터 (.dat 옆의 .dat.meta 파일)
+ * ============================================================================
+ *
+ * --convert가 블록 파일과 함께 기록하는 텍스트 파일로, 테이블 타입과 스키마,
+ * 블록 크기, 레코드/블록 수, 숫자 컬럼별 최소/최대값을 담는다. .dat 페이지 형식은
+ * 그대로 두므로 기존 리더와 임시 파티션 파일은 영향을 받지 않는다.
+ *
+ *   # dbsys table metadata
+ *   version 1
+ *   table_type PARTSUPP
+ *   block_size 4096
+ *   data_size 802816
+ *   record_count 8000
+ *   record_bytes 1507913
+ *   block_count 196
+ *   column partkey INT 1 2000
+ *   column suppkey INT 1 100
+ *   column availqty INT 3 9998
+ *   column supplycost DECIMAL 1.03999996 999.919983
+ *   column comment STRING
+ *
+ * data_size가 현재 .dat 크기와 다르거나 .dat가 메타데이터보다 나중에 수정됐으면
+ * 오래된 것으로 보고 무시한다 (load()가 false).
+ */
+
+// 숫자 컬럼 값 범위 (int_t와 float 모두 double로 정확히 표현됨)
+struct ColumnRange {
+    bool valid;      // 값이 하나라도 있었는지 (STRING 컬럼은 항상 false)
+    double min;
+    double max;
+
+    ColumnRange() : valid(false), min(0.0), max(0.0) {}
+
+    void add(double v) {
+        if (v != v) return;   // NaN은 범위에서 제외
+        if (!valid) {
+            min = max = v;
+            valid = true;
+        } else if (v < min) {
+            min = v;
+        } else if (v > max) {
+            max = v;
+        }
+    }
+};
+
+struct TableMetadata {
+    std::string table_type;
+    size_t block_size;
+    uint64_t data_size;        // .dat 파일 크기 (바이트)
+    uint64_t record_count;
+    uint64_t record_bytes;     // 인코딩된 레코드 바이트 합 (페이지 헤더/슬롯 제외)
+    uint64_t block_count;
+    std::vector<ColumnRange> ranges;   // 스키마 컬럼 순서
+
+    TableMetadata() : block_size(0), data_size(0), record_count(0), record_bytes(0),
+                      block_count(0) {}
+
+    // 빈 테이블로 초기화 (알 수 없는 타입이면 예외)
+    void reset(const std::string& type, size_t blk_size);
+
+    // 기록할 블록 하나를 통계에 반영
+    void addBlock(const Block& block);
+
+    const Schema& getSchema() const { return Schema::forTable(table_type); }
+
+    // data_file의 메타데이터 파일 기록 (data_size는 현재 파일 크기로 채움)
+    void save(const std::string& data_file);
+
+    // 메타데이터 읽기: 없거나 오래됐으면 false, 형식이 잘못됐으면 예외
+    static bool load(const std::string& data_file, TableMetadata& meta);
+
+    // 메타데이터 파일이 있으면 block_size와 같은지 확인 (다르면 예외)
+    static void checkBlockSize(const std::string& data_file, size_t block_size);
+
+    static std::string pathFor(const std::string& data_file) { return data_file + ".meta"; }
+};
+
+/**
+ * ============================================================================
+ * 페이지별 존 맵 (.dat 옆의 .dat.zones 파일)
+ * ============================================================================
+ *
+ * 정수 키 컬럼(이름이 "key"로 끝나는 INT 컬럼: partkey, suppkey, orderkey, custkey,
+ * nationkey, regionkey)마다 페이지 p에 들어 있는 값의 [min, max]를 기록한다.
+ * 키 순서로 생성된 TPC-H 파일에서는 페이지 범위가 좁으므로, 찾는 키 범위와 겹치지
+ * 않는 페이지는 읽지 않고 건너뛸 수 있다 (PageFilter).
+ *
+ * 페이지 수에 비례해 크므로 .meta와 달리 바이너리로 저장하고, 필요한 조인만 읽는다:
+ *   "DBSYSZM1" | u32 block_size | u32 K | u64 data_size | u64 pages | u32 column[K]
+ *   | i32 [pages][K][min, max]   (모두 리틀 엔디언)
+ */
+class ZoneMap {
+private:
+    const Schema* schema;
+    std::vector<uint32_t> columns;   // 범위를 기록하는 스키마 컬럼 번호 (슬롯 순서)
+    std::vector<int_t> bounds;       // 페이지 p, 슬롯 k의 min = [2 * (p * K + k)], max = 다음
+    size_t page_count;
+
+public:
+    explicit ZoneMap(const Schema& s);
+
+    // 기록할 블록 하나의 키 범위 추가 (페이지 순서대로)
+    void addBlock(const Block& block);
+
+    size_t getPageCount() const { return page_count; }
+
+    // 스키마 컬럼의 슬롯 번호 (범위를 기록하지 않는 컬럼이면 -1)
+    int findSlot(size_t column) const;
+
+    // 페이지의 키 범위가 [lo, hi]와 겹칠 수 있는지 (모르는 페이지는 true)
+    bool overlaps(size_t page, size_t slot, int_t lo, int_t hi) const {
+        if (page >= page_count) return true;
+        const int_t* range = &bounds[2 * (page * columns.size() + slot)];
+        return range[0] <= hi && lo <= range[1];
+    }
+
+    // data_file의 존 맵 파일 기록 (.dat를 다 쓴 뒤 호출)
+    void save(const std::string& data_file, size_t block_size) const;
+
+    // 존 맵 읽기: 없거나 오래됐거나 블록 크기가 다르면 nullptr, 형식이 잘못됐으면 예외
+    static std::shared_ptr<const ZoneMap> load(const std::string& data_file, size_t block_size);
+
+    static std::string pathFor(const std::string& data_file) { return data_file + ".zones"; }
+};
+
+// 순차 스캔에서 키 범위 [lo, hi]와 겹치지 않는 페이지를 건너뛰는 조건
+// (기본 생성 = 건너뛰지 않음, 리더는 값으로 복사해 보관)
+struct PageFilter {
+    std::shared_ptr<const ZoneMap> zones;
+    size_t slot;
+    int_t lo;
+    int_t hi;
+
+    PageFilter() : slot(0), lo(0), hi(0) {}
+    PageFilter(std::shared_ptr<const ZoneMap> z, size_t s, int_t l, int_t h)
+        : zones(std::move(z)), slot(s), lo(l), hi(h) {}
+
+    bool skip(size_t page) const { return zones && !zones->overlaps(page, slot, lo, hi); }
+};
+
+#endif // TABLE_METADATA_H
@@ -0,0 +1,87 @@
+#ifndef TBL_PARSER_H
+#define TBL_PARSER_H
+
+#include "common.h"
+#include "record.h"
+#include "schema.h"
+#include "simd_match.h"
+#include <string>
+#include <vector>
+
+/**
+ * ============================================================================
+ * TBL 청크 파서 (SIMD 구분자 탐색 + 제자리 숫자 파싱)
+ * ============================================================================
+ *
+ * 1단계: 64바이트씩 '|'와 '\n'을 SIMD로 비교해 비트마스크를 만들고, 설정된 비트를
+ *        순서대로 꺼내 필드/줄 경계를 얻는다 (MatchKernel과 같은 CPU 기능 감지 사용).
+ * 2단계: 줄마다 필드 구간을 스키마 컬럼에 대응시켜 레코드 바이트를 바로 인코딩한다.
+ *        INT/DECIMAL은 입력 버퍼 위에서 직접 파싱하고 중간 문자열을 만들지 않는다.
+ *
+ * 빠른 경로는 기존 *Record::fromCSV + toRecord와 같은 바이트를 내는 입력만 처리한다.
+ * 필드 수 부족, 공백/부호/지수가 붙은 숫자, 범위 초과, float 반올림 경계 등은 그 줄만
+ * 기존 파서로 넘기므로 (fallback) 결과와 오류 메시지가 항상 기존 변환과 같다.
+ */
+class TBLParser {
+public:
+    // 줄 하나를 기존 방식으로 파싱 (fromCSV + toRecord, 오류는 예외)
+    typedef Record (*LineParser)(const std::string& line);
+
+    // 파싱 결과: 인코딩된 레코드를 이어 붙인 바이트와 레코드별 크기
+    struct Output {
+        std::vector<char> encoded;
+        std::vector<uint32_t> sizes;
+        std::vector<uint32_t> line_offsets;  // 레코드별 원본 줄 시작 위치 (청크 기준)
+        std::vector<std::string> errors;     // 파싱 오류 메시지 (입력 순서)
+
+        void clear() {
+            encoded.clear();
+            sizes.clear();
+            line_offsets.clear();
+            errors.clear();
+        }
+    };
+
+    // 64바이트에서 '|' 또는 '\n' 위치의 비트마스크
+    typedef uint64_t (*MaskFn)(const char* data);
+
+private:
+    const Schema* schema;
+    LineParser legacy;
+    MatchKernel kernel;
+    MaskFn mask_fn;
+    bool fast_path;
+    size_t fallback_lines;
+    size_t supplier_key_col;            // "Supplier#NNN" 형식을 허용하는 컬럼 (PARTSUPP.suppkey)
+    std::vector<size_t> field_ends;     // 현재 줄의 '|' 위치 (스크래치)
+
+    // 빠른 경로로 줄 [begin, end)를 인코딩 (불가능하면 false, out은 변경 없음)
+    bool encodeLine(const char* data, size_t begin, size_t end, Output& out);
+
+    // 기존 파서로 줄 [begin, end) 하나 처리
+    void parseLegacy(const char* data, size_t begin, size_t end, Output& out);
+
+public:
+    explicit TBLParser(const std::string& table_type,
+                       MatchKernel k = KeyMatcher::detectKernel());
+
+    // data[0..size)를 줄 단위로 파싱해 out 뒤에 추가 (std::getline과 같은 줄 분할,
+    // 빈 줄은 건너뜀)
+    void parseChunk(const char* data, size_t size, Output& out);
+
+    // false이면 모든 줄을 기존 파서로 처리 (벤치마크 기준선용)
+    void setFastPath(bool enabled) { fast_path = enabled; }
+
+    MatchKernel getKernel() const { return kernel; }
+    size_t getFallbackLines() const { return fallback_lines; }
+
+    // 테이블 타입의 기존 줄 파서 (알 수 없는 타입이면 예외)
+    static LineParser legacyParserFor(const std::string& table_type);
+
+    // 숫자 필드 제자리 파싱: 기존 safe_stoi / safe_stof와 같은 값을 낼 수 있는
+    // 단순한 형식(부호 '-', 숫자, 소수점)만 받아들이고 나머지는 false
+    static bool parseInt(const char* begin, const char* end, int_t& value);
+    static bool parseDecimal(const char* begin, const char* end, decimal_t& value);
+};
+
+#endif // TBL_PARSER_H
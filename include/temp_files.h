@@ -0,0 +1,24 @@
+#ifndef TEMP_FILES_H
+#define TEMP_FILES_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 임시 파일 목록 (Grace/Hybrid 해시 조인 파티션, 외부 정렬 run)
+ *
+ * 만든 파일 이름을 names에 넣어 두면 소멸자에서 모두 삭제한다.
+ * 예외로 빠져나가도 정리되며, 이미 지운 파일은 remove가 실패할 뿐 문제없다.
+ */
+struct TempFileSet {
+    std::vector<std::string> names;
+
+    ~TempFileSet() {
+        for (const auto& name : names) {
+            std::remove(name.c_str());
+        }
+    }
+};
+
+#endif // TEMP_FILES_H
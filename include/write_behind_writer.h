@@ -0,0 +1,86 @@
+#ifndef WRITE_BEHIND_WRITER_H
+#define WRITE_BEHIND_WRITER_H
+
+#include "common.h"
+#include "block.h"
+#include "table.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * ============================================================================
+ * Write-behind 출력 라이터
+ * ============================================================================
+ *
+ * 조인 스레드는 가득 찬 출력 블록을 flushBlock()으로 넘기고, 풀에서 빈 블록을
+ * 받아 바로 조인을 계속한다 (버퍼 교환이므로 복사 없음). 백그라운드 플러시
+ * 스레드는 대기 중인 블록들을 최대 MAX_BATCH개씩 모아 pwritev 한 번으로 파일
+ * 끝에 기록하고, 블록을 비워 풀로 돌려준다.
+ *
+ * 조인 스레드는 풀의 빈 블록이 모두 기록 대기 중일 때만 멈추며, 이 대기 시간은
+ * getStallTime()으로 확인할 수 있다. 기록 오류는 다음 flushBlock() 또는 close()에서
+ * 예외로 다시 던진다. 첫 오류 이후 플러시 스레드는 더 기록하지 않고 대기열의 블록을
+ * 비워 풀로 돌려주기만 한다.
+ */
+class WriteBehindWriter : public BlockSink {
+private:
+    std::string filename;
+    int fd;
+    size_t block_size;
+    Statistics* stats;
+
+    std::vector<Block> pool;           // 풀 블록 (free / queued가 인덱스로 참조)
+    std::vector<size_t> free_blocks;   // 비어 있는 풀 블록
+    std::deque<size_t> queued;         // 기록 대기 중인 풀 블록 (파일 순서)
+    bool closing;
+    std::exception_ptr error;
+    bool error_reported;               // error를 이미 호출자에게 던졌는지
+
+    std::mutex mutex;
+    std::condition_variable work_ready;    // 플러시 스레드 깨우기
+    std::condition_variable block_freed;   // 빈 블록을 기다리는 조인 스레드 깨우기
+    std::thread flush_thread;
+
+    // 통계 (플러시 스레드 전용 / mutex 보호)
+    size_t write_calls;
+    size_t blocks_written;
+    double stall_time;
+
+    // 플러시 스레드 본체
+    void flushLoop();
+
+    // 빈 풀 블록 하나 확보 (mutex 잡은 상태, 없으면 대기)
+    size_t takeFreeBlock(std::unique_lock<std::mutex>& lock);
+
+public:
+    static const size_t DEFAULT_POOL_BLOCKS = 16;
+    static const size_t MAX_BATCH = 16;    // pwritev 한 번에 모으는 최대 블록 수
+
+    WriteBehindWriter(const std::string& fname, size_t blk_size = DEFAULT_BLOCK_SIZE,
+                      size_t pool_blocks = DEFAULT_POOL_BLOCKS, Statistics* st = nullptr);
+    ~WriteBehindWriter();
+
+    WriteBehindWriter(const WriteBehindWriter&) = delete;
+    WriteBehindWriter& operator=(const WriteBehindWriter&) = delete;
+
+    // 블록 내용을 빈 풀 블록에 복사해 기록 대기열에 추가
+    bool writeBlock(const Block* block) override;
+
+    // 블록 버퍼를 빈 풀 블록과 교환하고 기록 대기열에 추가 (block은 빈 블록이 됨)
+    void flushBlock(Block* block) override;
+
+    // 대기 중인 블록을 모두 기록하고 파일 닫기
+    void close();
+
+    size_t getWriteCalls() const { return write_calls; }
+    size_t getBlocksWritten() const { return blocks_written; }
+    double getStallTime() const { return stall_time; }
+    size_t getMemoryUsage() const { return pool.size() * block_size; }
+};
+
+#endif // WRITE_BEHIND_WRITER_H
@@ -0,0 +1,115 @@
+#include "arena.h"
+#include <algorithm>
+#include <new>
+#include <utility>
+
+const size_t Arena::MIN_CHUNK;
+const size_t Arena::MAX_CHUNK;
+
+Arena::Arena()
+    : current(0), ptr(nullptr), end(nullptr), used_bytes(0), reserved_bytes(0),
+      next_chunk(MIN_CHUNK) {}
+
+Arena::~Arena() {
+    release();
+}
+
+Arena::Arena(Arena&& other) noexcept
+    : chunks(std::move(other.chunks)), current(other.current), ptr(other.ptr), end(other.end),
+      used_bytes(other.used_bytes), reserved_bytes(other.reserved_bytes),
+      next_chunk(other.next_chunk) {
+    other.chunks.clear();
+    other.current = 0;
+    other.ptr = other.end = nullptr;
+    other.used_bytes = other.reserved_bytes = 0;
+    other.next_chunk = MIN_CHUNK;
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        release();
+        chunks.swap(other.chunks);
+        std::swap(current, other.current);
+        std::swap(ptr, other.ptr);
+        std::swap(end, other.end);
+        std::swap(used_bytes, other.used_bytes);
+        std::swap(reserved_bytes, other.reserved_bytes);
+        std::swap(next_chunk, other.next_chunk);
+    }
+    return *this;
+}
+
+void Arena::addChunk(size_t size) {
+    Chunk chunk;
+    chunk.data = new char[size];
+    chunk.size = size;
+    chunks.push_back(chunk);
+    reserved_bytes += size;
+    next_chunk = std::min(next_chunk * 2, MAX_CHUNK);
+
+    current = chunks.size() - 1;
+    ptr = chunk.data;
+    end = chunk.data + size;
+}
+
+char* Arena::allocateSlow(size_t n) {
+    // rewind 후에는 뒤에 남은 청크를 순서대로 다시 씀 (n이 안 들어가는 청크는 건너뜀)
+    size_t next = chunks.empty() ? 0 : current + 1;
+    while (next < chunks.size() && chunks[next].size < n) {
+        next++;
+    }
+    if (next < chunks.size()) {
+        current = next;
+        ptr = chunks[next].data;
+        end = ptr + chunks[next].size;
+    } else {
+        addChunk(std::max(n, next_chunk));
+    }
+
+    char* p = ptr;
+    ptr += n;
+    used_bytes += n;
+    return p;
+}
+
+void Arena::reserve(size_t bytes) {
+    if (static_cast<size_t>(end - ptr) >= bytes) {
+        return;
+    }
+    // 뒤에 남은 청크에 들어가면 그대로 두고, 아니면 한 청크로 확보
+    for (size_t i = chunks.empty() ? 0 : current + 1; i < chunks.size(); ++i) {
+        if (chunks[i].size >= bytes) return;
+    }
+    addChunk(bytes);
+}
+
+void Arena::rewind() {
+    current = 0;
+    used_bytes = 0;
+    if (chunks.empty()) {
+        ptr = end = nullptr;
+    } else {
+        ptr = chunks[0].data;
+        end = ptr + chunks[0].size;
+    }
+}
+
+void Arena::trim() {
+    while (chunks.size() > current + 1) {
+        reserved_bytes -= chunks.back().size;
+        delete[] chunks.back().data;
+        chunks.pop_back();
+    }
+}
+
+void Arena::release() {
+    for (const Chunk& chunk : chunks) {
+        delete[] chunk.data;
+    }
+    chunks.clear();
+    current = 0;
+    ptr = end = nullptr;
+    used_bytes = 0;
+    reserved_bytes = 0;
+    next_chunk = MIN_CHUNK;
+}
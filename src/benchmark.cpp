@@ -0,0 +1,584 @@
+#include "benchmark.h"
+#include "block_pool.h"
+#include "flat_hash_table.h"
+#include "io_backend.h"
+#include "record.h"
+#include "table.h"
+#include "tbl_parser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ============================================================================
+// 측정 보조 함수
+// ============================================================================
+
+typedef std::chrono::high_resolution_clock BenchClock;
+
+static double secondsSince(const BenchClock::time_point& start) {
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// 현재 RSS (바이트)
+static size_t currentRSS() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// 프로세스 최대 RSS (바이트)
+static size_t peakRSS() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+// 자식 프로세스에서 측정한 결과 (파이프로 그대로 전달하므로 POD)
+struct HashTableBenchResult {
+    int ok;
+    double build_time;
+    double probe_time;
+    size_t matches;
+    size_t checksum;       // 매칭된 Build 레코드 길이 합 (두 구현의 결과 비교용)
+    size_t memory;         // 자료구조 메모리 (FlatHashTable은 실측, map은 추정)
+    size_t rss_growth;     // 측정 시작 대비 최대 RSS 증가
+};
+
+// fn을 fork한 자식에서 실행해 최대 RSS가 다른 측정과 섞이지 않게 함
+template <typename Fn>
+static HashTableBenchResult runIsolated(Fn fn) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error("Failed to create pipe for benchmark");
+    }
+
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("Failed to fork benchmark process");
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        HashTableBenchResult result = HashTableBenchResult();
+        try {
+            result = fn();
+            result.ok = 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Benchmark error: " << e.what() << std::endl;
+        }
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        (void)written;
+        _exit(0);
+    }
+
+    close(fds[1]);
+    HashTableBenchResult result = HashTableBenchResult();
+    ssize_t received = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    waitpid(pid, nullptr, 0);
+
+    if (received != static_cast<ssize_t>(sizeof(result)) || !result.ok) {
+        throw std::runtime_error("Benchmark child process failed");
+    }
+    return result;
+}
+
+// ============================================================================
+// 해시 테이블 벤치마크
+// ============================================================================
+
+void Benchmark::hashTables(const std::string& build_file,
+                           const std::string& probe_file,
+                           const std::string& build_type,
+                           const std::string& probe_type,
+                           const std::string& join_key,
+                           size_t block_size) {
+    const size_t PROBE_ROUNDS = 5;
+
+    const Schema* build_schema = &Schema::forTable(build_type);
+    const Schema* probe_schema = &Schema::forTable(probe_type);
+    size_t build_key_col = build_schema->getKeyColumn(join_key);
+    size_t probe_key_col = probe_schema->getKeyColumn(join_key);
+
+    // 입력을 미리 메모리에 올려 디스크 I/O를 측정에서 제외
+    std::vector<Block> build_blocks;
+    size_t build_records = 0;
+    size_t build_bytes = 0;
+    {
+        TableReader reader(build_file, block_size);
+        Block block(block_size);
+        while (reader.readBlock(&block)) {
+            build_records += block.getRecordCount();
+            build_bytes += block.getUsedSize();
+            build_blocks.push_back(std::move(block));
+            block = Block(block_size);
+        }
+    }
+
+    std::vector<int_t> probe_keys;
+    {
+        TableReader reader(probe_file, block_size);
+        Block block(block_size);
+        while (reader.readBlock(&block)) {
+            RecordReader rec_reader(&block, probe_schema);
+            while (rec_reader.hasNext()) {
+                probe_keys.push_back(rec_reader.readNext().getInt(probe_key_col));
+            }
+        }
+    }
+
+    std::cout << "\n=== Hash Table Benchmark ===" << std::endl;
+    std::cout << "Build: " << build_file << " (" << build_records << " records, "
+              << build_blocks.size() << " blocks)" << std::endl;
+    std::cout << "Probe: " << probe_file << " (" << probe_keys.size() << " keys x "
+              << PROBE_ROUNDS << " rounds)" << std::endl;
+
+    // ========== 기존 방식: unordered_map<int_t, vector<Record>> ==========
+    HashTableBenchResult map_result = runIsolated([&]() {
+        HashTableBenchResult r = HashTableBenchResult();
+        size_t rss_start = currentRSS();
+
+        auto start = BenchClock::now();
+        std::unordered_map<int_t, std::vector<Record>> table;
+        for (const Block& block : build_blocks) {
+            RecordReader rec_reader(&block, build_schema);
+            while (rec_reader.hasNext()) {
+                RecordView record = rec_reader.readNext();
+                table[record.getInt(build_key_col)].push_back(record.materialize());
+            }
+        }
+        r.build_time = secondsSince(start);
+
+        start = BenchClock::now();
+        for (size_t round = 0; round < PROBE_ROUNDS; ++round) {
+            for (int_t key : probe_keys) {
+                auto it = table.find(key);
+                if (it == table.end()) continue;
+                for (const Record& record : it->second) {
+                    r.checksum += record.getSerializedSize();
+                    r.matches++;
+                }
+            }
+        }
+        r.probe_time = secondsSince(start);
+
+        // 노드 + 버킷 + 벡터 + Record 객체 + 레코드 바이트 (할당 헤더 16 bytes 가정)
+        size_t node_size = sizeof(int_t) + sizeof(std::vector<Record>) + 2 * sizeof(void*) + 16;
+        r.memory = table.bucket_count() * sizeof(void*) + table.size() * node_size +
+                   build_records * (sizeof(Record) + 16) + build_bytes;
+        r.rss_growth = peakRSS() - rss_start;
+        return r;
+    });
+
+    // ========== FlatHashTable (HashJoin 사용) ==========
+    HashTableBenchResult flat_result = runIsolated([&]() {
+        HashTableBenchResult r = HashTableBenchResult();
+        size_t rss_start = currentRSS();
+
+        auto start = BenchClock::now();
+        FlatHashTable table;
+        table.reserve(build_records, build_bytes);
+        for (const Block& block : build_blocks) {
+            RecordReader rec_reader(&block, build_schema);
+            while (rec_reader.hasNext()) {
+                RecordView record = rec_reader.readNext();
+                table.insert(record.getInt(build_key_col), record.getData(), record.getSize());
+            }
+        }
+        r.build_time = secondsSince(start);
+
+        start = BenchClock::now();
+        for (size_t round = 0; round < PROBE_ROUNDS; ++round) {
+            for (int_t key : probe_keys) {
+                for (uint32_t e = table.find(key); e != FlatHashTable::NONE; e = table.next(e)) {
+                    r.checksum += table.payloadSize(e);
+                    r.matches++;
+                }
+            }
+        }
+        r.probe_time = secondsSince(start);
+
+        r.memory = table.getMemoryUsage();
+        r.rss_growth = peakRSS() - rss_start;
+        return r;
+    });
+
+    // ========== 결과 ==========
+    size_t total_probes = probe_keys.size() * PROBE_ROUNDS;
+    auto printRow = [&](const char* name, const HashTableBenchResult& r) {
+        double mprobes = r.probe_time > 0 ? total_probes / r.probe_time / 1e6 : 0.0;
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+                  << std::setprecision(4)
+                  << std::setw(11) << r.build_time
+                  << std::setw(11) << r.probe_time
+                  << std::setprecision(2)
+                  << std::setw(12) << mprobes
+                  << std::setw(13) << (r.memory / 1024.0 / 1024.0)
+                  << std::setw(14) << (r.rss_growth / 1024.0 / 1024.0) << std::endl;
+    };
+
+    std::cout << "\n" << std::left << std::setw(16) << "Table" << std::right
+              << std::setw(11) << "Build (s)" << std::setw(11) << "Probe (s)"
+              << std::setw(12) << "Mprobes/s" << std::setw(13) << "Memory (MB)"
+              << std::setw(14) << "Peak RSS +MB" << std::endl;
+    printRow("unordered_map", map_result);
+    printRow("FlatHashTable", flat_result);
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    if (map_result.matches != flat_result.matches || map_result.checksum != flat_result.checksum) {
+        std::cout << "WARNING: match results differ (" << map_result.matches << " vs "
+                  << flat_result.matches << ")" << std::endl;
+    } else {
+        std::cout << "Matches per round: " << (flat_result.matches / PROBE_ROUNDS) << std::endl;
+    }
+
+    if (flat_result.probe_time > 0 && flat_result.build_time > 0) {
+        std::cout << "Probe speedup: " << (map_result.probe_time / flat_result.probe_time)
+                  << "x, Build speedup: " << (map_result.build_time / flat_result.build_time)
+                  << "x" << std::endl;
+    }
+}
+
+// ============================================================================
+// 블록 I/O 백엔드 벤치마크
+// ============================================================================
+
+// 파일의 페이지 캐시 비우기 (더티 페이지가 없는 입력 파일이면 권한 없이 가능)
+static void dropFileCache(const std::string& file) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + file);
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+void Benchmark::ioBackends(const std::string& table_file, size_t block_size,
+                           size_t queue_depth) {
+    struct Variant {
+        const char* name;
+        IoBackend backend;
+        bool direct;
+    };
+    const Variant variants[] = {
+        {"ifstream",       IoBackend::STREAM, false},
+        {"pread",          IoBackend::PREAD,  false},
+        {"pread+direct",   IoBackend::PREAD,  true},
+        {"io_uring",       IoBackend::URING,  false},
+        {"io_uring+direct", IoBackend::URING, true},
+    };
+
+    size_t file_blocks = TableReader(table_file, block_size).getBlockCount();
+    double file_mb = file_blocks * block_size / 1024.0 / 1024.0;
+
+    std::cout << "\n=== Block I/O Backend Benchmark ===" << std::endl;
+    std::cout << "Table: " << table_file << " (" << file_blocks << " blocks, "
+              << file_mb << " MB)" << std::endl;
+    std::cout << "io_uring queue depth: " << queue_depth
+              << (IoUring::isSupported() ? "" : " (io_uring unavailable)") << std::endl;
+
+    std::cout << "\n" << std::left << std::setw(18) << "Backend" << std::right
+              << std::setw(11) << "Time (s)" << std::setw(10) << "MB/s"
+              << std::setw(12) << "Records" << "  Note" << std::endl;
+
+    for (const Variant& v : variants) {
+        IoOptions requested;
+        requested.backend = v.backend;
+        requested.direct = v.direct;
+        requested.queue_depth = queue_depth;
+
+        std::cout << std::left << std::setw(18) << v.name << std::right;
+
+        // 요청과 다른 설정으로 대체되는 경우는 측정하지 않음
+        IoOptions resolved = resolveIoOptions(requested, block_size);
+        if (resolved.backend != requested.backend || resolved.direct != requested.direct) {
+            std::cout << std::setw(33) << "-" << "  unavailable here" << std::endl;
+            continue;
+        }
+
+        try {
+            dropFileCache(table_file);
+
+            auto start = BenchClock::now();
+            TableReader reader(table_file, block_size, nullptr, requested);
+            Block block(block_size);
+            size_t records = 0;
+            while (reader.readBlock(&block)) {
+                records += block.getRecordCount();
+            }
+            double seconds = secondsSince(start);
+
+            std::cout << std::fixed << std::setprecision(4) << std::setw(11) << seconds
+                      << std::setprecision(1) << std::setw(10)
+                      << (seconds > 0 ? file_mb / seconds : 0.0)
+                      << std::setw(12) << records << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::setprecision(6);
+        } catch (const std::exception& e) {
+            std::cout << std::setw(33) << "-" << "  " << e.what() << std::endl;
+        }
+    }
+}
+
+// ============================================================================
+// TBL 파싱 처리량
+// ============================================================================
+
+void Benchmark::ingest(const std::string& tbl_file, const std::string& table_type) {
+    const size_t CHUNK_SIZE = 4 * 1024 * 1024;
+
+    std::ifstream input(tbl_file, std::ios::binary);
+    if (!input.is_open()) {
+        throw std::runtime_error("Failed to open TBL file: " + tbl_file);
+    }
+    std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    double file_mb = text.size() / 1024.0 / 1024.0;
+
+    // 변환 경로와 같이 줄 경계에서 자른 청크 구간
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t begin = 0; begin < text.size();) {
+        size_t end = std::min(begin + CHUNK_SIZE, text.size());
+        size_t newline = text.find('\n', end == text.size() ? end : end - 1);
+        end = (end == text.size() || newline == std::string::npos) ? text.size() : newline + 1;
+        chunks.push_back(std::make_pair(begin, end));
+        begin = end;
+    }
+
+    struct Variant {
+        const char* name;
+        bool fast_path;
+        MatchKernel kernel;
+    };
+    const Variant variants[] = {
+        {"fromCSV (legacy)",  false, MatchKernel::SCALAR},
+        {"tokenizer scalar",  true,  MatchKernel::SCALAR},
+        {"tokenizer sse2",    true,  MatchKernel::SSE2},
+        {"tokenizer avx2",    true,  MatchKernel::AVX2},
+    };
+    MatchKernel best = KeyMatcher::detectKernel();
+
+    std::cout << "\n=== TBL Ingest Benchmark ===" << std::endl;
+    std::cout << "Input: " << tbl_file << " (" << table_type << ", " << file_mb << " MB, "
+              << chunks.size() << " chunks)" << std::endl;
+
+    std::cout << "\n" << std::left << std::setw(20) << "Parser" << std::right
+              << std::setw(11) << "Time (s)" << std::setw(10) << "MB/s"
+              << std::setw(12) << "Records" << std::setw(11) << "Fallback"
+              << "  Output" << std::endl;
+
+    size_t reference = 0;
+    for (const Variant& v : variants) {
+        std::cout << std::left << std::setw(20) << v.name << std::right;
+        if (static_cast<int>(v.kernel) > static_cast<int>(best)) {
+            std::cout << std::setw(44) << "-" << "  unsupported on this CPU" << std::endl;
+            continue;
+        }
+
+        TBLParser parser(table_type, v.kernel);
+        parser.setFastPath(v.fast_path);
+        TBLParser::Output out;
+        size_t records = 0;
+        size_t checksum = 14695981039346656037ULL;
+
+        auto start = BenchClock::now();
+        for (const auto& chunk : chunks) {
+            out.clear();
+            parser.parseChunk(text.data() + chunk.first, chunk.second - chunk.first, out);
+            records += out.sizes.size();
+
+            // 인코딩 결과 비교용 FNV-1a (8바이트 단위)
+            const char* p = out.encoded.data();
+            size_t n = out.encoded.size();
+            for (size_t i = 0; i + 8 <= n; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, p + i, sizeof(word));
+                checksum = (checksum ^ word) * 1099511628211ULL;
+            }
+            for (size_t i = n & ~static_cast<size_t>(7); i < n; ++i) {
+                checksum = (checksum ^ static_cast<unsigned char>(p[i])) * 1099511628211ULL;
+            }
+        }
+        double seconds = secondsSince(start);
+
+        if (!v.fast_path) {
+            reference = checksum;
+        }
+
+        std::cout << std::fixed << std::setprecision(4) << std::setw(11) << seconds
+                  << std::setprecision(1) << std::setw(10)
+                  << (seconds > 0 ? file_mb / seconds : 0.0)
+                  << std::setw(12) << records << std::setw(11) << parser.getFallbackLines()
+                  << "  " << (checksum == reference ? "identical" : "DIFFERS") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+}
+
+// ============================================================================
+// 블록 할당 / 초기화
+// ============================================================================
+
+// 컴파일러가 측정 대상 메모리 연산을 없애지 못하도록 포인터를 외부로 노출
+static void escape(const void* p) {
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+void Benchmark::blockPool(size_t block_size, size_t iterations) {
+    const size_t RECORD_SIZE = 100;
+
+    // 이전 방식: 블록마다 posix_memalign + 전체 memset, clear()마다 전체 memset
+    auto legacyAlloc = [block_size]() {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, Block::IO_ALIGNMENT, block_size) != 0) {
+            throw std::bad_alloc();
+        }
+        std::memset(buffer, 0, block_size);
+        return static_cast<char*>(buffer);
+    };
+    auto legacyClear = [block_size](Block& block) {
+        std::memset(block.getData(), 0, block_size);
+        block.clear();
+    };
+
+    std::vector<char> record(RECORD_SIZE, 'x');
+    size_t records_per_block = 0;
+    {
+        Block probe(block_size);
+        while (probe.append(record.data(), record.size())) {
+            records_per_block++;
+        }
+    }
+
+    struct Result {
+        double legacy;    // 초
+        double pooled;
+        size_t legacy_zeroed;   // 연산당 0으로 채운 바이트
+        size_t pooled_zeroed;
+    };
+
+    // 1) 블록 생성 + 소멸
+    Result alloc;
+    {
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            char* buffer = legacyAlloc();
+            escape(buffer);
+            std::free(buffer);
+        }
+        alloc.legacy = secondsSince(start);
+
+        start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            Block block(block_size);
+            escape(block.getData());
+        }
+        alloc.pooled = secondsSince(start);
+        alloc.legacy_zeroed = block_size;
+        alloc.pooled_zeroed = Block::PAGE_HEADER_SIZE;
+    }
+
+    // 2) 빈 블록 재사용 (clear)
+    Result reset;
+    {
+        Block block(block_size);
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            legacyClear(block);
+            escape(block.getData());
+        }
+        reset.legacy = secondsSince(start);
+
+        start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            block.clear();
+            escape(block.getData());
+        }
+        reset.pooled = secondsSince(start);
+        reset.legacy_zeroed = block_size;
+        reset.pooled_zeroed = Block::PAGE_HEADER_SIZE;
+    }
+
+    // 3) 출력 블록 한 장 채우기 → 기록 준비 → 재사용 (조인 출력 경로)
+    //    새 방식은 clear() 대신 기록 직전 zeroFreeSpace()가 남은 빈 공간만 채움
+    Result cycle;
+    {
+        Block block(block_size);
+        auto fill = [&]() {
+            for (size_t r = 0; r < records_per_block; ++r) {
+                block.append(record.data(), record.size());
+            }
+        };
+
+        auto start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fill();
+            escape(block.getData());
+            legacyClear(block);
+        }
+        cycle.legacy = secondsSince(start);
+
+        start = BenchClock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            fill();
+            block.zeroFreeSpace();
+            escape(block.getData());
+            block.clear();
+        }
+        cycle.pooled = secondsSince(start);
+        fill();
+        cycle.legacy_zeroed = block_size;
+        cycle.pooled_zeroed = block.getFreeSize() + Block::PAGE_HEADER_SIZE;
+    }
+
+    BlockPool& pool = BlockPool::forSize(block_size);
+
+    std::cout << "\n=== Block Allocation Benchmark ===" << std::endl;
+    std::cout << "Block size: " << block_size << " bytes, " << iterations
+              << " iterations, " << records_per_block << " x " << RECORD_SIZE
+              << "-byte records per full block" << std::endl;
+    std::cout << "Pool: " << pool.getSlabCount() << " slabs ("
+              << pool.getHugeSlabCount() << " hugetlb), " << pool.getCapacity()
+              << " blocks" << (BlockPool::getHugePages() ? ", huge pages requested" : "")
+              << std::endl;
+
+    std::cout << "\n" << std::left << std::setw(20) << "Operation" << std::right
+              << std::setw(13) << "Legacy ns/op" << std::setw(11) << "Pool ns/op"
+              << std::setw(9) << "Speedup" << std::setw(16) << "Zeroed B/op"
+              << std::setw(13) << "Saved GB" << std::endl;
+
+    auto printRow = [&](const char* name, const Result& r) {
+        double saved_gb = static_cast<double>(r.legacy_zeroed - r.pooled_zeroed) * iterations /
+                          1024.0 / 1024.0 / 1024.0;
+        std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+                  << std::setprecision(1)
+                  << std::setw(13) << r.legacy * 1e9 / iterations
+                  << std::setw(11) << r.pooled * 1e9 / iterations
+                  << std::setprecision(2)
+                  << std::setw(8) << (r.pooled > 0 ? r.legacy / r.pooled : 0.0) << "x"
+                  << std::setw(16)
+                  << (std::to_string(r.legacy_zeroed) + " -> " + std::to_string(r.pooled_zeroed))
+                  << std::setw(13) << saved_gb << std::endl;
+    };
+    printRow("alloc + free", alloc);
+    printRow("clear (reuse)", reset);
+    printRow("fill + flush cycle", cycle);
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
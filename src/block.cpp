@@ -2,56 +2,158 @@
 #include <cstring>
 #include <stdexcept>
 
-Block::Block(size_t size) : block_size(size), used_size(0) {
-    data = new char[block_size];
-    std::memset(data, 0, block_size);
+const size_t Block::IO_ALIGNMENT;
+
+// 헤더 필드 위치
+static const size_t HEADER_RECORD_COUNT = 0;
+static const size_t HEADER_FREE_OFFSET = sizeof(uint32_t);
+
+Block::Block(size_t size) : block_size(size) {
+    if (block_size <= PAGE_HEADER_SIZE + SLOT_SIZE) {
+        throw std::runtime_error("Block size too small for slotted page: " +
+                                 std::to_string(block_size));
+    }
+    // O_DIRECT 읽기/쓰기에 그대로 넘길 수 있도록 정렬된 풀 버퍼 사용
+    pool = &BlockPool::forSize(block_size);
+    data = own_data = pool->allocate();
+    clear();
 }
 
 Block::~Block() {
-    delete[] data;
+    if (own_data) {
+        pool->release(own_data);
+    }
 }
 
 Block::Block(Block&& other) noexcept
-    : data(other.data), block_size(other.block_size), used_size(other.used_size) {
-    other.data = nullptr;
+    : data(other.data), own_data(other.own_data), block_size(other.block_size),
+      pool(other.pool) {
+    other.data = other.own_data = nullptr;
     other.block_size = 0;
-    other.used_size = 0;
 }
 
 Block& Block::operator=(Block&& other) noexcept {
     if (this != &other) {
-        delete[] data;
+        if (own_data) {
+            pool->release(own_data);
+        }
         data = other.data;
+        own_data = other.own_data;
         block_size = other.block_size;
-        used_size = other.used_size;
-        other.data = nullptr;
+        pool = other.pool;
+        other.data = other.own_data = nullptr;
         other.block_size = 0;
-        other.used_size = 0;
     }
     return *this;
 }
 
-bool Block::append(const char* record_data, size_t record_size) {
-    // 크기 체크 (4 bytes for size + record data)
-    size_t required_size = sizeof(uint32_t) + record_size;
+uint32_t Block::readHeader(size_t field_offset) const {
+    uint32_t value;
+    std::memcpy(&value, data + field_offset, sizeof(uint32_t));
+    return value;
+}
 
-    if (isFull(required_size)) {
+void Block::writeHeader(size_t field_offset, uint32_t value) {
+    std::memcpy(data + field_offset, &value, sizeof(uint32_t));
+}
+
+size_t Block::getRecordCount() const {
+    if (!data) return 0;
+    return readHeader(HEADER_RECORD_COUNT);
+}
+
+size_t Block::getUsedSize() const {
+    if (!data) return 0;
+    return readHeader(HEADER_FREE_OFFSET) + getRecordCount() * SLOT_SIZE;
+}
+
+bool Block::append(const char* record_data, size_t record_size) {
+    char* dest = allocateRecord(record_size);
+    if (!dest) {
         return false;
     }
 
-    // 레코드 크기 저장
-    uint32_t size_val = static_cast<uint32_t>(record_size);
-    std::memcpy(data + used_size, &size_val, sizeof(uint32_t));
-    used_size += sizeof(uint32_t);
-
     // 레코드 데이터 저장
-    std::memcpy(data + used_size, record_data, record_size);
-    used_size += record_size;
+    std::memcpy(dest, record_data, record_size);
+    return true;
+}
+
+char* Block::allocateRecord(size_t record_size) {
+    if (isView()) {
+        throw std::runtime_error("Cannot append to a read-only block view");
+    }
+
+    // 레코드 데이터 + 슬롯 하나가 들어갈 공간 확인
+    if (isFull(record_size)) {
+        return nullptr;
+    }
+
+    uint32_t count = readHeader(HEADER_RECORD_COUNT);
+    uint32_t free_offset = readHeader(HEADER_FREE_OFFSET);
+
+    // 슬롯 기록 (페이지 끝에서부터)
+    uint32_t slot[2] = {free_offset, static_cast<uint32_t>(record_size)};
+    std::memcpy(data + block_size - (count + 1) * SLOT_SIZE, slot, SLOT_SIZE);
+
+    // 헤더 갱신
+    writeHeader(HEADER_RECORD_COUNT, count + 1);
+    writeHeader(HEADER_FREE_OFFSET, free_offset + static_cast<uint32_t>(record_size));
+
+    return data + free_offset;
+}
+
+const char* Block::getRecord(size_t slot_no, size_t& length) const {
+    if (slot_no >= getRecordCount()) {
+        throw std::out_of_range("Slot number out of range: " + std::to_string(slot_no));
+    }
+
+    uint32_t slot[2];
+    std::memcpy(slot, data + block_size - (slot_no + 1) * SLOT_SIZE, SLOT_SIZE);
+
+    length = slot[1];
+    return data + slot[0];
+}
+
+bool Block::isValid() const {
+    if (!data) return false;
+
+    size_t count = readHeader(HEADER_RECORD_COUNT);
+    size_t free_offset = readHeader(HEADER_FREE_OFFSET);
+
+    // 헤더 + 레코드 영역 + 슬롯 배열이 페이지 안에 있어야 함
+    if (free_offset < PAGE_HEADER_SIZE || count > block_size / SLOT_SIZE ||
+        free_offset + count * SLOT_SIZE > block_size) {
+        return false;
+    }
+
+    // 모든 슬롯이 레코드 영역 안을 가리켜야 함
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t slot[2];
+        std::memcpy(slot, data + block_size - (i + 1) * SLOT_SIZE, SLOT_SIZE);
+        if (slot[0] < PAGE_HEADER_SIZE ||
+            static_cast<size_t>(slot[0]) + slot[1] > free_offset) {
+            return false;
+        }
+    }
 
     return true;
 }
 
 void Block::clear() {
-    used_size = 0;
-    std::memset(data, 0, block_size);
+    if (!own_data) return;
+
+    // 이전 내용이 남아 있어도 헤더만으로 빈 페이지가 됨 (뷰이면 자체 버퍼로 돌아감)
+    data = own_data;
+    writeHeader(HEADER_RECORD_COUNT, 0);
+    writeHeader(HEADER_FREE_OFFSET, static_cast<uint32_t>(PAGE_HEADER_SIZE));
+}
+
+void Block::zeroFreeSpace() const {
+    if (!data || isView()) return;
+
+    size_t free_offset = readHeader(HEADER_FREE_OFFSET);
+    size_t slots_begin = block_size - getRecordCount() * SLOT_SIZE;
+    if (free_offset < slots_begin) {
+        std::memset(data + free_offset, 0, slots_begin - free_offset);
+    }
 }
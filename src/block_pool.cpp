@@ -0,0 +1,138 @@
+#include "block_pool.h"
+#include "block.h"
+#include <atomic>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+
+const size_t BlockPool::SLAB_ALIGNMENT;
+
+static std::atomic<bool> huge_pages_enabled(false);
+
+static size_t roundUp(size_t value, size_t unit) {
+    return (value + unit - 1) / unit * unit;
+}
+
+BlockPool::BlockPool(size_t blk_size)
+    : block_size(blk_size),
+      stride(roundUp(blk_size, Block::IO_ALIGNMENT)),
+      slab_bytes(roundUp(blk_size, SLAB_ALIGNMENT)),
+      huge_slabs(0),
+      in_use(0) {
+    if (block_size == 0) {
+        throw std::runtime_error("Block pool needs a non-zero block size");
+    }
+}
+
+BlockPool::~BlockPool() {
+    for (char* slab : slabs) {
+        munmap(slab, slab_bytes);
+    }
+}
+
+void BlockPool::addSlab() {
+    char* slab = nullptr;
+
+    if (huge_pages_enabled.load(std::memory_order_relaxed)) {
+        void* addr = mmap(nullptr, slab_bytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr != MAP_FAILED) {
+            slab = static_cast<char*>(addr);
+            huge_slabs++;
+        }
+    }
+
+    if (!slab) {
+        // THP가 슬랩을 huge page로 채울 수 있도록 2MB 경계에 맞춰 앞뒤를 잘라냄
+        size_t span = slab_bytes + SLAB_ALIGNMENT;
+        void* addr = mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char* base = static_cast<char*>(addr);
+        char* aligned = reinterpret_cast<char*>(
+            roundUp(reinterpret_cast<uintptr_t>(base), SLAB_ALIGNMENT));
+        if (aligned > base) {
+            munmap(base, aligned - base);
+        }
+        size_t tail = (base + span) - (aligned + slab_bytes);
+        if (tail > 0) {
+            munmap(aligned + slab_bytes, tail);
+        }
+        slab = aligned;
+
+        // 힌트 실패는 성능 문제일 뿐이므로 무시
+        if (huge_pages_enabled.load(std::memory_order_relaxed)) {
+            madvise(slab, slab_bytes, MADV_HUGEPAGE);
+        }
+    }
+
+    slabs.push_back(slab);
+
+    // 앞쪽 버퍼가 먼저 나가도록 역순으로 추가
+    size_t count = slab_bytes / stride;
+    for (size_t i = count; i-- > 0;) {
+        free_list.push_back(slab + i * stride);
+    }
+}
+
+char* BlockPool::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (free_list.empty()) {
+        addSlab();
+    }
+    char* buffer = free_list.back();
+    free_list.pop_back();
+    in_use++;
+    return buffer;
+}
+
+void BlockPool::release(char* buffer) {
+    if (!buffer) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    free_list.push_back(buffer);
+    in_use--;
+}
+
+size_t BlockPool::getSlabCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slabs.size();
+}
+
+size_t BlockPool::getHugeSlabCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return huge_slabs;
+}
+
+size_t BlockPool::getBlocksInUse() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return in_use;
+}
+
+size_t BlockPool::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return slabs.size() * (slab_bytes / stride);
+}
+
+BlockPool& BlockPool::forSize(size_t blk_size) {
+    // 정적 객체의 Block이 어떤 순서로 소멸해도 풀이 남아 있도록 해제하지 않음
+    static std::mutex registry_mutex;
+    static std::map<size_t, BlockPool*>* registry = new std::map<size_t, BlockPool*>();
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    BlockPool*& pool = (*registry)[blk_size];
+    if (!pool) {
+        pool = new BlockPool(blk_size);
+    }
+    return *pool;
+}
+
+void BlockPool::setHugePages(bool enabled) {
+    huge_pages_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool BlockPool::getHugePages() {
+    return huge_pages_enabled.load(std::memory_order_relaxed);
+}
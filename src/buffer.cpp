@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "table.h"
 #include <stdexcept>
 
 BufferManager::BufferManager(size_t num_buffers, size_t blk_size)
@@ -33,3 +34,226 @@ void BufferManager::clearAll() {
         buffer->clear();
     }
 }
+
+// ============================================================================
+// BufferPool
+// ============================================================================
+
+ReplacementPolicy parseReplacementPolicy(const std::string& name) {
+    if (name == "clock") return ReplacementPolicy::CLOCK;
+    if (name == "lru") return ReplacementPolicy::LRU;
+    if (name == "lru-k") return ReplacementPolicy::LRU_K;
+    if (name == "mru") return ReplacementPolicy::MRU;
+    throw std::runtime_error("Unknown replacement policy: " + name);
+}
+
+const uint64_t BufferPool::RETAINED_PERIOD_FACTOR;
+
+const char* replacementPolicyName(ReplacementPolicy policy) {
+    switch (policy) {
+        case ReplacementPolicy::CLOCK: return "clock";
+        case ReplacementPolicy::LRU: return "lru";
+        case ReplacementPolicy::LRU_K: return "lru-k";
+        case ReplacementPolicy::MRU: return "mru";
+    }
+    return "unknown";
+}
+
+BufferPool::BufferPool(size_t num_frames, size_t blk_size, ReplacementPolicy replacement,
+                       Statistics* st, size_t k)
+    : retained_period(RETAINED_PERIOD_FACTOR * num_frames),
+      policy(replacement), block_size(blk_size),
+      history_depth(replacement == ReplacementPolicy::LRU_K ? k : 1),
+      clock_tick(0), hand(0), stats(st) {
+
+    if (num_frames == 0) {
+        throw std::runtime_error("Buffer pool needs at least 1 frame");
+    }
+    if (history_depth == 0) {
+        throw std::runtime_error("LRU-K needs K >= 1");
+    }
+
+    frames.resize(num_frames);
+    for (Frame& frame : frames) {
+        frame.block = std::make_unique<Block>(block_size);
+        frame.key = 0;
+        frame.valid = false;
+        frame.dirty = false;
+        frame.referenced = false;
+        frame.pin_count = 0;
+        frame.history.assign(history_depth, 0);
+    }
+    page_table.reserve(num_frames);
+}
+
+// 상위 16비트 파일 번호, 하위 48비트 페이지 번호
+uint64_t BufferPool::pageKey(size_t file_id, size_t page_no) {
+    if (file_id >= (static_cast<uint64_t>(1) << 16) ||
+        page_no >= (static_cast<uint64_t>(1) << 48)) {
+        throw std::out_of_range("Buffer pool page id out of range");
+    }
+    return (static_cast<uint64_t>(file_id) << 48) | page_no;
+}
+
+void BufferPool::touch(Frame& frame) {
+    frame.referenced = true;
+    for (size_t i = history_depth - 1; i > 0; --i) {
+        frame.history[i] = frame.history[i - 1];
+    }
+    frame.history[0] = ++clock_tick;
+}
+
+void BufferPool::retainHistory(const Frame& frame) {
+    if (policy != ReplacementPolicy::LRU_K) return;
+
+    // 보관 기간이 지난 기록 정리 (기간 안의 기록은 많아야 retained_period개라 분할 상환 O(1))
+    if (retained.size() >= 2 * retained_period) {
+        for (auto it = retained.begin(); it != retained.end();) {
+            if (it->second[0] + retained_period < clock_tick) {
+                it = retained.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    retained[frame.key] = frame.history;
+}
+
+void BufferPool::restoreHistory(Frame& frame) {
+    frame.history.assign(history_depth, 0);
+    if (policy != ReplacementPolicy::LRU_K) return;
+
+    auto it = retained.find(frame.key);
+    if (it == retained.end()) return;
+    if (it->second[0] + retained_period >= clock_tick) {
+        frame.history = it->second;
+    }
+    retained.erase(it);
+}
+
+size_t BufferPool::findVictim() {
+    size_t n = frames.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (!frames[i].valid) {
+            return i;
+        }
+    }
+
+    if (policy == ReplacementPolicy::CLOCK) {
+        // 한 바퀴에서 참조 비트를 모두 지우므로 두 바퀴 안에 pin되지 않은 프레임을 찾음
+        for (size_t step = 0; step < 2 * n; ++step) {
+            Frame& frame = frames[hand];
+            size_t current = hand;
+            hand = (hand + 1) % n;
+            if (frame.pin_count > 0) continue;
+            if (frame.referenced) {
+                frame.referenced = false;
+                continue;
+            }
+            return current;
+        }
+    } else {
+        // LRU: history[0] 최소, MRU: history[0] 최대,
+        // LRU_K: history[K-1] 최소 (0 = K번 미만 사용), 같으면 history[0] 최소
+        size_t victim = n;
+        for (size_t i = 0; i < n; ++i) {
+            const Frame& frame = frames[i];
+            if (frame.pin_count > 0) continue;
+            if (victim == n) {
+                victim = i;
+                continue;
+            }
+            const Frame& best = frames[victim];
+            bool better;
+            if (policy == ReplacementPolicy::MRU) {
+                better = frame.history[0] > best.history[0];
+            } else {
+                uint64_t kth = frame.history[history_depth - 1];
+                uint64_t best_kth = best.history[history_depth - 1];
+                better = kth < best_kth || (kth == best_kth && frame.history[0] < best.history[0]);
+            }
+            if (better) {
+                victim = i;
+            }
+        }
+        if (victim < n) {
+            return victim;
+        }
+    }
+
+    throw std::runtime_error("Buffer pool: all " + std::to_string(n) + " frames are pinned");
+}
+
+void BufferPool::writeFrame(Frame& frame) {
+    if (!write_back) {
+        throw std::runtime_error("Buffer pool: dirty page without a write-back target");
+    }
+    write_back(static_cast<size_t>(frame.key >> 48),
+               static_cast<size_t>(frame.key & ((static_cast<uint64_t>(1) << 48) - 1)),
+               *frame.block);
+    frame.dirty = false;
+}
+
+Block* BufferPool::pin(BlockSource& source, size_t file_id, size_t page_no) {
+    uint64_t key = pageKey(file_id, page_no);
+
+    auto it = page_table.find(key);
+    if (it != page_table.end()) {
+        Frame& frame = frames[it->second];
+        frame.pin_count++;
+        touch(frame);
+        if (stats) {
+            stats->buffer_hits++;
+        }
+        return frame.block.get();
+    }
+
+    size_t victim = findVictim();
+    Frame& frame = frames[victim];
+    if (frame.valid) {
+        if (frame.dirty) {
+            writeFrame(frame);
+        }
+        page_table.erase(frame.key);
+        retainHistory(frame);
+        frame.valid = false;
+    }
+
+    frame.block->clear();
+    if (!source.readBlockAt(page_no, frame.block.get())) {
+        return nullptr;
+    }
+    if (stats) {
+        stats->buffer_misses++;
+    }
+
+    frame.key = key;
+    frame.valid = true;
+    frame.dirty = false;
+    frame.pin_count = 1;
+    restoreHistory(frame);
+    touch(frame);
+    page_table[key] = victim;
+    return frame.block.get();
+}
+
+void BufferPool::unpin(size_t file_id, size_t page_no, bool dirty) {
+    auto it = page_table.find(pageKey(file_id, page_no));
+    if (it == page_table.end() || frames[it->second].pin_count == 0) {
+        throw std::runtime_error("Buffer pool: unpin of page " + std::to_string(page_no) +
+                                 " that is not pinned");
+    }
+    Frame& frame = frames[it->second];
+    frame.pin_count--;
+    if (dirty) {
+        frame.dirty = true;
+    }
+}
+
+void BufferPool::flushAll() {
+    for (Frame& frame : frames) {
+        if (frame.valid && frame.dirty) {
+            writeFrame(frame);
+        }
+    }
+}
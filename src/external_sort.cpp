@@ -0,0 +1,641 @@
+#include "external_sort.h"
+#include "external_table_reader.h"
+#include "table_metadata.h"
+#include "temp_files.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+// 작업 공간이 가득 찼을 때 압축 전에 비워 둘 최소 비율 (압축이 레코드마다 일어나지 않도록)
+static const size_t COMPACT_SLACK_DIVISOR = 8;
+
+static int compareStrings(const StringRef& a, const StringRef& b) {
+    int c = std::memcmp(a.data, b.data, std::min(a.size, b.size));
+    if (c != 0) return c;
+    return a.size < b.size ? -1 : (a.size > b.size ? 1 : 0);
+}
+
+// ============================================================================
+// Replacement selection 작업 공간
+// ============================================================================
+
+// 작업 공간의 레코드 하나 (힙 원소)
+struct RunEntry {
+    size_t run;         // 내보낼 run 번호
+    double num_key;     // INT/DECIMAL 키 (STRING 키면 사용하지 않음)
+    char* data;         // 작업 공간 안의 레코드 바이트
+    uint32_t size;
+    uint32_t region;    // data가 들어 있는 작업 공간 블록
+};
+
+/**
+ * 작업 공간 블록들 위의 가변 길이 레코드 저장소
+ *
+ * 블록마다 앞에서부터 레코드를 이어 붙이고 (레코드는 블록 경계를 넘지 않음),
+ * 내보낸 레코드 자리는 바로 재사용하지 않는다. 끝까지 차면 compact()가 살아 있는
+ * 레코드를 주소 순으로 앞으로 당겨 빈 공간을 뒤쪽에 모은다. 같은 순서로 다시 채우면
+ * 각 레코드의 새 위치는 예전 위치보다 앞이므로 memmove로 제자리 압축할 수 있다.
+ */
+class SortWorkspace {
+private:
+    std::vector<char*> regions;   // BufferManager 블록의 데이터 버퍼 (슬롯 페이지로 쓰지 않음)
+    size_t region_size;
+    size_t fill_region;           // 다음 할당 위치
+    size_t fill_offset;
+    size_t live_bytes;            // 아직 내보내지 않은 레코드 바이트 합
+
+public:
+    SortWorkspace(BufferManager& buffers, size_t first, size_t region_sz)
+        : region_size(region_sz), fill_region(0), fill_offset(0), live_bytes(0) {
+        for (size_t i = first; i < buffers.getBufferCount(); ++i) {
+            regions.push_back(buffers.getBuffer(i)->getData());
+        }
+    }
+
+    size_t getCapacity() const { return regions.size() * region_size; }
+    size_t getFreeBytes() const { return getCapacity() - live_bytes; }
+
+    // n바이트 자리를 entry에 기록 (할당 위치 뒤에 자리가 없으면 false)
+    bool allocate(size_t n, RunEntry& entry) {
+        while (fill_region < regions.size()) {
+            if (region_size - fill_offset >= n) {
+                entry.data = regions[fill_region] + fill_offset;
+                entry.size = static_cast<uint32_t>(n);
+                entry.region = static_cast<uint32_t>(fill_region);
+                fill_offset += n;
+                live_bytes += n;
+                return true;
+            }
+            fill_region++;
+            fill_offset = 0;
+        }
+        return false;
+    }
+
+    void release(const RunEntry& entry) { live_bytes -= entry.size; }
+
+    // entries의 레코드를 작업 공간 앞쪽으로 모음 (entries의 순서는 바꾸지 않음)
+    void compact(std::vector<RunEntry>& entries) {
+        std::vector<size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (entries[a].region != entries[b].region) {
+                return entries[a].region < entries[b].region;
+            }
+            return entries[a].data < entries[b].data;
+        });
+
+        fill_region = 0;
+        fill_offset = 0;
+        live_bytes = 0;
+        for (size_t idx : order) {
+            RunEntry& entry = entries[idx];
+            char* src = entry.data;
+            allocate(entry.size, entry);
+            std::memmove(entry.data, src, entry.size);
+        }
+    }
+};
+
+// ============================================================================
+// Loser tree
+// ============================================================================
+
+/**
+ * k-way 병합용 loser tree
+ *
+ * 잎 k..2k-1이 입력 0..k-1, 내부 노드 1..k-1에는 그 노드의 대결에서 진 입력 번호,
+ * tree[0]에는 전체 승자를 둔다. 승자 입력이 다음 레코드로 넘어가면 그 잎에서 뿌리까지
+ * 경로의 패자들과만 다시 겨루므로 레코드당 비교는 ⌈log2 k⌉번이다
+ * (이진 힙의 pop + push는 형제끼리도 비교하여 최대 약 2 log2 k번).
+ * less(a, b)는 입력 a의 현재 레코드가 b보다 먼저 나가야 하는지 (끝난 입력은 가장 큼).
+ */
+template <typename Less>
+class LoserTree {
+private:
+    std::vector<size_t> tree;
+    size_t k;
+    Less less;
+
+public:
+    LoserTree(size_t inputs, Less cmp) : tree(std::max<size_t>(inputs, 1), 0), k(inputs), less(cmp) {
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            winners[k + i] = i;
+        }
+        for (size_t n = k - 1; n > 0; --n) {
+            size_t a = winners[2 * n];
+            size_t b = winners[2 * n + 1];
+            if (less(b, a)) {
+                winners[n] = b;
+                tree[n] = a;
+            } else {
+                winners[n] = a;
+                tree[n] = b;
+            }
+        }
+        tree[0] = k > 1 ? winners[1] : 0;
+    }
+
+    size_t winner() const { return tree[0]; }
+
+    // 승자 입력의 현재 레코드가 바뀐 뒤 호출
+    void replay() {
+        size_t w = tree[0];
+        for (size_t n = (w + k) / 2; n > 0; n /= 2) {
+            if (less(tree[n], w)) {
+                std::swap(tree[n], w);
+            }
+        }
+        tree[0] = w;
+    }
+};
+
+/**
+ * 정렬 결과 파일의 .meta/.zones를 모으는 BlockSink
+ *
+ * 기록하는 블록을 메타데이터와 존 맵에 반영한 뒤 실제 라이터로 넘긴다.
+ * 마지막 병합의 출력과, run이 하나뿐이라 그대로 이름을 바꿀 첫 run에 쓴다.
+ */
+class SidecarSink : public BlockSink {
+private:
+    BlockSink* out;
+    TableMetadata meta;
+    ZoneMap zones;
+
+public:
+    SidecarSink(const std::string& table_type, size_t block_size)
+        : out(nullptr), zones(Schema::forTable(table_type)) {
+        meta.reset(table_type, block_size);
+    }
+
+    void setOutput(BlockSink* sink) { out = sink; }
+
+    bool writeBlock(const Block* block) override {
+        meta.addBlock(*block);
+        zones.addBlock(*block);
+        return out->writeBlock(block);
+    }
+
+    // data_file을 다 쓰고 닫은 뒤 호출
+    void save(const std::string& data_file) {
+        meta.save(data_file);
+        zones.save(data_file, meta.block_size);
+    }
+};
+
+// run r개를 fanin개씩 병합해 하나로 만드는 데 필요한 패스 수
+static size_t mergePasses(size_t runs, size_t fanin) {
+    size_t passes = 0;
+    for (size_t r = runs; r > 1; r = (r + fanin - 1) / fanin) {
+        passes++;
+    }
+    return passes;
+}
+
+template <typename Less>
+static LoserTree<Less> makeLoserTree(size_t inputs, Less less) {
+    return LoserTree<Less>(inputs, less);
+}
+
+// ============================================================================
+// External Sort 구현
+// ============================================================================
+
+ExternalSort::ExternalSort(
+    const std::string& in_file,
+    const std::string& out_file,
+    const std::string& type,
+    const std::string& key_name,
+    size_t buf_size,
+    size_t blk_size)
+    : input_file(in_file),
+      output_file(out_file),
+      table_type(type),
+      sort_key(key_name),
+      buffer_size(buf_size),
+      block_size(blk_size),
+      schema(&Schema::forTable(type)),
+      key_col(0),
+      key_type(FieldType::INT),
+      input_blocks(0),
+      input_records(0),
+      initial_runs(0),
+      initial_run_blocks(0),
+      workspace_blocks(0),
+      merge_fanin(0),
+      run_window(0),
+      merge_window(0),
+      compactions(0),
+      parse_memory(0),
+      run_time(0.0),
+      merge_time(0.0) {
+    int col = schema->findColumn(key_name);
+    if (col < 0) {
+        throw std::runtime_error("Invalid sort key '" + key_name + "' for table type '" +
+                                 type + "'");
+    }
+    key_col = static_cast<size_t>(col);
+    key_type = schema->getColumn(key_col).type;
+}
+
+int ExternalSort::compareKeys(const RecordView& a, const RecordView& b) const {
+    switch (key_type) {
+    case FieldType::INT: {
+        int_t x = a.getInt(key_col);
+        int_t y = b.getInt(key_col);
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+    case FieldType::DECIMAL: {
+        decimal_t x = a.getDecimal(key_col);
+        decimal_t y = b.getDecimal(key_col);
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+    case FieldType::STRING:
+        return compareStrings(a.getString(key_col), b.getString(key_col));
+    }
+    return 0;
+}
+
+std::string ExternalSort::runFileName(size_t pass, size_t index) const {
+    return output_file + ".run." + std::to_string(pass) + "_" + std::to_string(index) + ".tmp";
+}
+
+std::vector<SortedRun> ExternalSort::generateRuns(BufferManager& buffers, const IoOptions& io,
+                                                  SidecarSink& first_run,
+                                                  std::vector<std::string>& temp) {
+    std::unique_ptr<BlockSource> reader;
+    if (isExternalTable(input_file)) {
+        ExternalTableReader* tbl_reader =
+            new ExternalTableReader(input_file, table_type, block_size, &stats);
+        parse_memory = tbl_reader->getMemoryUsage();
+        reader.reset(tbl_reader);
+    } else {
+        reader.reset(new TableReader(input_file, block_size, &stats, io));
+    }
+    Block* input_block = buffers.getBuffer(0);
+    Block* run_block = buffers.getBuffer(1);
+    run_block->clear();
+    SortWorkspace workspace(buffers, 2, block_size);
+
+    std::vector<RunEntry> heap;
+    std::vector<SortedRun> runs;
+    std::unique_ptr<TableWriter> run_writer;
+    BlockSink* run_sink = nullptr;    // 첫 run은 first_run을 거쳐 기록
+    size_t current_run = 0;
+
+    // 마지막으로 내보낸 키 (작업 공간의 그 레코드 자리는 곧 덮어쓰일 수 있으므로 복사)
+    double last_num = 0.0;
+    std::string last_str;
+
+    auto numericKey = [&](const RecordView& record) -> double {
+        if (key_type == FieldType::INT) return record.getInt(key_col);
+        if (key_type == FieldType::DECIMAL) return record.getDecimal(key_col);
+        return 0.0;
+    };
+
+    // 힙 순서: (run, 키) 오름차순. std::*_heap은 최대 힙이므로 "나중에 나갈 것"을 앞으로
+    auto after = [&](const RunEntry& a, const RunEntry& b) {
+        if (a.run != b.run) return a.run > b.run;
+        if (key_type != FieldType::STRING) return a.num_key > b.num_key;
+        return compareKeys(RecordView(schema, a.data, a.size),
+                           RecordView(schema, b.data, b.size)) > 0;
+    };
+
+    auto closeRun = [&]() {
+        if (!run_block->isEmpty()) {
+            run_sink->flushBlock(run_block);
+            runs.back().blocks++;
+        }
+        run_writer->close();
+        run_writer.reset();
+        run_sink = nullptr;
+    };
+
+    // 힙의 최솟값을 run에 기록 (run 번호가 바뀌면 새 run 파일 시작)
+    auto emitMin = [&]() {
+        std::pop_heap(heap.begin(), heap.end(), after);
+        RunEntry entry = heap.back();
+        heap.pop_back();
+
+        if (!run_writer || entry.run != current_run) {
+            if (run_writer) closeRun();
+            current_run = entry.run;
+            SortedRun run;
+            run.file = runFileName(0, runs.size());
+            temp.push_back(run.file);
+            runs.push_back(run);
+            run_writer.reset(new TableWriter(run.file, &spill_stats, io));
+            run_sink = run_writer.get();
+            if (runs.size() == 1) {
+                first_run.setOutput(run_sink);
+                run_sink = &first_run;
+            }
+        }
+
+        if (!run_block->append(entry.data, entry.size)) {
+            run_sink->flushBlock(run_block);
+            runs.back().blocks++;
+            run_block->append(entry.data, entry.size);
+        }
+        runs.back().records++;
+
+        if (key_type == FieldType::STRING) {
+            StringRef key = RecordView(schema, entry.data, entry.size).getString(key_col);
+            last_str.assign(key.data, key.size);
+        } else {
+            last_num = entry.num_key;
+        }
+        workspace.release(entry);
+    };
+
+    // 새 레코드가 마지막으로 내보낸 키보다 작은지 (그러면 현재 run에 넣을 수 없음)
+    auto belowLast = [&](const RecordView& record, double num_key) {
+        if (key_type != FieldType::STRING) return num_key < last_num;
+        StringRef last = {last_str.data(), last_str.size()};
+        return compareStrings(record.getString(key_col), last) < 0;
+    };
+
+    while (reader->readBlock(input_block)) {
+        input_blocks++;
+        RecordReader rec_reader(input_block, schema);
+
+        while (rec_reader.hasNext()) {
+            RecordView record = rec_reader.readNext();
+            size_t n = record.getSize();
+            input_records++;
+
+            // 자리가 없으면 여유가 충분히 생길 때까지 최솟값을 내보낸 뒤 한 번에 압축
+            RunEntry entry;
+            while (!workspace.allocate(n, entry)) {
+                if (heap.empty()) {
+                    throw std::runtime_error("Record of " + std::to_string(n) +
+                                             " bytes does not fit in the sort workspace");
+                }
+                size_t target = std::max(workspace.getCapacity() / COMPACT_SLACK_DIVISOR, n);
+                emitMin();
+                while (!heap.empty() && workspace.getFreeBytes() < target) {
+                    emitMin();
+                }
+                workspace.compact(heap);
+                compactions++;
+            }
+
+            std::memcpy(entry.data, record.getData(), n);
+            entry.num_key = numericKey(record);
+            entry.run = (run_writer && belowLast(record, entry.num_key)) ? current_run + 1
+                                                                         : current_run;
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), after);
+        }
+    }
+
+    while (!heap.empty()) {
+        emitMin();
+    }
+    if (run_writer) {
+        closeRun();
+    }
+    return runs;
+}
+
+SortedRun ExternalSort::mergeRuns(const std::vector<SortedRun>& inputs, BufferManager& buffers,
+                                  const IoOptions& io, BlockSink& writer) {
+    size_t k = inputs.size();
+    std::vector<std::unique_ptr<TableReader>> readers;
+    std::vector<Block*> blocks;
+    std::vector<RecordReader> cursors;
+    std::vector<RecordView> current(k);
+    std::vector<char> exhausted(k, 0);
+
+    for (size_t i = 0; i < k; ++i) {
+        readers.emplace_back(new TableReader(inputs[i].file, block_size, &spill_stats, io));
+        blocks.push_back(buffers.getBuffer(i));
+        blocks[i]->clear();
+        cursors.emplace_back(blocks[i], schema);
+    }
+
+    // 입력 i의 다음 레코드 (블록을 다 읽었으면 다음 블록, 파일 끝이면 exhausted)
+    auto advance = [&](size_t i) {
+        while (!cursors[i].hasNext()) {
+            if (!readers[i]->readBlock(blocks[i])) {
+                exhausted[i] = 1;
+                return;
+            }
+            cursors[i].reset();
+        }
+        current[i] = cursors[i].readNext();
+    };
+
+    // 같은 키는 번호가 작은 입력 (먼저 만들어진 run) 먼저
+    auto less = [&](size_t a, size_t b) {
+        if (exhausted[a]) return false;
+        if (exhausted[b]) return true;
+        int c = compareKeys(current[a], current[b]);
+        return c < 0 || (c == 0 && a < b);
+    };
+
+    for (size_t i = 0; i < k; ++i) {
+        advance(i);
+    }
+    auto tree = makeLoserTree(k, less);
+
+    Block* output_block = buffers.getBuffer(k);
+    output_block->clear();
+    SortedRun result;
+
+    while (!exhausted[tree.winner()]) {
+        size_t w = tree.winner();
+        const RecordView& record = current[w];
+        if (!output_block->append(record.getData(), record.getSize())) {
+            writer.flushBlock(output_block);
+            result.blocks++;
+            output_block->append(record.getData(), record.getSize());
+        }
+        result.records++;
+
+        advance(w);
+        tree.replay();
+    }
+
+    if (!output_block->isEmpty()) {
+        writer.flushBlock(output_block);
+        result.blocks++;
+    }
+    return result;
+}
+
+void ExternalSort::execute() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::cout << "\n=== External Sort Execution ===" << std::endl;
+    std::cout << "Input: " << input_file << " (" << table_type << ")" << std::endl;
+    std::cout << "Sort Key: " << sort_key << std::endl;
+    std::cout << "Output: " << output_file << std::endl;
+
+    if (buffer_size < 3) {
+        throw std::runtime_error("External sort needs at least 3 buffer blocks "
+                                 "(input, run output and workspace)");
+    }
+
+    // io_uring 창은 리더/라이터마다 따로 잡히므로 깊이 1로 줄이고 B에서 뺀다
+    // (작업 공간이 1블록 미만이 되면 창 없이 pread)
+    IoOptions run_io = limitQueueDepth(getDefaultIoOptions(), buffer_size >= 5 ? 1 : 0);
+    run_window = ioWindowBlocks(run_io);
+    TempFileSet temp_files;
+
+    // 이전 출력의 메타데이터/존 맵은 정렬이 끝나기 전까지 유효하지 않음
+    std::remove(TableMetadata::pathFor(output_file).c_str());
+    std::remove(ZoneMap::pathFor(output_file).c_str());
+    SidecarSink sidecars(table_type, block_size);
+
+    // ========== 1단계: replacement selection으로 run 생성 ==========
+    // (run 생성 버퍼는 병합 버퍼를 잡기 전에 해제: 두 단계가 각각 B 안에서 동작)
+    std::vector<SortedRun> runs;
+    {
+        BufferManager run_buffers(buffer_size - 2 * run_window, block_size);
+        workspace_blocks = run_buffers.getBufferCount() - 2;
+        std::cout << "Generating runs (" << workspace_blocks << " workspace blocks)..."
+                  << std::endl;
+        runs = generateRuns(run_buffers, run_io, sidecars, temp_files.names);
+    }
+    initial_runs = runs.size();
+    for (const SortedRun& run : runs) {
+        initial_run_blocks += run.blocks;
+    }
+    stats.sort_runs = initial_runs;
+    size_t memory_blocks = buffer_size;
+    merge_fanin = buffer_size - 1;
+
+    auto runs_done = std::chrono::high_resolution_clock::now();
+    run_time = std::chrono::duration<double>(runs_done - start_time).count();
+    std::cout << "Runs generated: " << initial_runs << " from " << input_records
+              << " records in " << input_blocks << " blocks" << std::endl;
+
+    // ========== 2단계: fan-in개씩 병합 ==========
+    if (runs.size() <= 1) {
+        // run 하나면 이미 정렬된 결과 (입력이 비었으면 빈 출력 파일)
+        if (runs.empty()) {
+            TableWriter(output_file, &stats).close();
+        } else if (std::rename(runs[0].file.c_str(), output_file.c_str()) != 0) {
+            throw std::runtime_error("Cannot rename " + runs[0].file + " to " + output_file);
+        }
+        sidecars.save(output_file);
+        stats.output_records = input_records;
+    } else {
+        // 병합 입력/출력마다 창 w블록이면 fan-in은 B/(1+w) - 1.
+        // 그 때문에 패스가 늘면 창 없이 pread로 B-1개씩 병합한다.
+        IoOptions merge_io = limitQueueDepth(getDefaultIoOptions(), 1);
+        merge_window = ioWindowBlocks(merge_io);
+        merge_fanin = buffer_size / (1 + merge_window) - 1;
+        if (merge_window > 0 &&
+            (merge_fanin < 2 ||
+             mergePasses(runs.size(), merge_fanin) > mergePasses(runs.size(), buffer_size - 1))) {
+            merge_io = limitQueueDepth(merge_io, 0);
+            merge_window = 0;
+            merge_fanin = buffer_size - 1;
+        }
+        BufferManager buffers(merge_fanin + 1, block_size);
+        memory_blocks = std::max(memory_blocks, (merge_fanin + 1) * (1 + merge_window));
+
+        size_t pass = 0;
+        while (runs.size() > merge_fanin) {
+            pass++;
+            std::vector<SortedRun> next;
+            for (size_t first = 0; first < runs.size(); first += merge_fanin) {
+                size_t last = std::min(runs.size(), first + merge_fanin);
+                std::vector<SortedRun> group(runs.begin() + first, runs.begin() + last);
+
+                // 혼자 남은 run은 다음 패스로 그대로 넘김
+                if (group.size() == 1) {
+                    next.push_back(group[0]);
+                    continue;
+                }
+
+                std::string file = runFileName(pass, next.size());
+                temp_files.names.push_back(file);
+                TableWriter writer(file, &spill_stats, merge_io);
+                SortedRun merged = mergeRuns(group, buffers, merge_io, writer);
+                writer.close();
+                merged.file = file;
+                next.push_back(merged);
+
+                // 병합한 run은 바로 삭제 (임시 파일은 최대 약 2N 블록)
+                for (const SortedRun& run : group) {
+                    std::remove(run.file.c_str());
+                }
+            }
+            std::cout << "Merge pass " << pass << ": " << runs.size() << " -> "
+                      << next.size() << " runs" << std::endl;
+            runs.swap(next);
+        }
+
+        // 마지막 병합은 출력 파일로
+        TableWriter writer(output_file, &stats, merge_io);
+        SidecarSink output(table_type, block_size);
+        output.setOutput(&writer);
+        SortedRun result = mergeRuns(runs, buffers, merge_io, output);
+        writer.close();
+        output.save(output_file);
+        stats.output_records = result.records;
+        stats.merge_passes = pass + 1;
+        std::cout << "Merge pass " << stats.merge_passes << ": " << runs.size()
+                  << " -> 1 run (output)" << std::endl;
+    }
+
+    // 임시 run I/O를 전체 통계에 합산
+    stats.spill_block_reads = spill_stats.block_reads;
+    stats.spill_block_writes = spill_stats.block_writes;
+    stats.block_reads += spill_stats.block_reads;
+    stats.block_writes += spill_stats.block_writes;
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    merge_time = std::chrono::duration<double>(end_time - runs_done).count();
+    stats.elapsed_time = std::chrono::duration<double>(end_time - start_time).count();
+    // .tbl 입력의 파싱 버퍼는 run 생성 동안만 쓰지만 B와 별도이므로 더해서 보고
+    stats.memory_usage = memory_blocks * block_size + parse_memory;
+
+    printStatistics();
+}
+
+void ExternalSort::printStatistics() const {
+    std::cout << "\n=== External Sort Statistics ===" << std::endl;
+    std::cout << "Block Reads: " << stats.block_reads << std::endl;
+    std::cout << "Block Writes: " << stats.block_writes << std::endl;
+    std::cout << "Output Records: " << stats.output_records << std::endl;
+    std::cout << "Elapsed Time: " << stats.elapsed_time << " seconds" << std::endl;
+    std::cout << "Memory Usage: " << (stats.memory_usage / 1024.0 / 1024.0) << " MB" << std::endl;
+    std::cout << "Spill Reads: " << stats.spill_block_reads << std::endl;
+    std::cout << "Spill Writes: " << stats.spill_block_writes << std::endl;
+
+    std::cout << "Initial Runs: " << stats.sort_runs;
+    if (stats.sort_runs > 0) {
+        double avg = static_cast<double>(initial_run_blocks) / stats.sort_runs;
+        std::cout << " (average " << avg << " blocks = "
+                  << avg / workspace_blocks << "x workspace)";
+    }
+    std::cout << std::endl;
+    std::cout << "Merge Passes: " << stats.merge_passes << " (fan-in " << merge_fanin << ")"
+              << std::endl;
+    if (run_window > 0 || merge_window > 0) {
+        std::cout << "io_uring Window Blocks: " << run_window << " per run file, "
+                  << merge_window << " per merge file" << std::endl;
+    }
+    std::cout << "Workspace Compactions: " << compactions << std::endl;
+    std::cout << "Run Generation Time: " << run_time << " seconds" << std::endl;
+    std::cout << "Merge Time: " << merge_time << " seconds" << std::endl;
+
+    // 교과서 비용: B블록 run ⌈N/B⌉개를 B-1개씩 병합
+    size_t textbook_passes =
+        mergePasses((input_blocks + buffer_size - 1) / buffer_size, buffer_size - 1);
+    std::cout << "Total I/O: " << (stats.block_reads + stats.block_writes) << std::endl;
+    std::cout << "Textbook Cost 2N(1 + ceil(log_{B-1}(N/B))): "
+              << 2 * input_blocks * (1 + textbook_passes) << " (N = " << input_blocks
+              << ", B = " << buffer_size << ", " << textbook_passes << " merge passes)"
+              << std::endl;
+}
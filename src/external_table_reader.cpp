@@ -0,0 +1,346 @@
+#include "external_table_reader.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 위치 이동 직후에는 작은 청크로 시작해 두 배씩 늘림 (모어셀 단위 임의 접근 대비)
+static const size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+// 색인 없이 페이지 수를 어림할 때 텍스트 대비 인코딩된 페이지 크기 (%).
+// 페이지 헤더/슬롯과 블록 끝 빈 공간 때문에 .dat는 .tbl보다 조금 크다 (TPC-H에서 약 110%)
+static const uint64_t TBL_PAGE_ESTIMATE_PERCENT = 125;
+
+static size_t external_parse_threads = 0;
+
+const size_t ExternalTableReader::MAX_CHUNK_SIZE;
+
+void setExternalParseThreads(size_t threads) {
+    external_parse_threads = threads;
+}
+
+size_t getExternalParseThreads() {
+    return external_parse_threads;
+}
+
+bool isExternalTable(const std::string& file) {
+    static const std::string EXTENSION = ".tbl";
+    return file.size() > EXTENSION.size() &&
+           file.compare(file.size() - EXTENSION.size(), EXTENSION.size(), EXTENSION) == 0;
+}
+
+std::unique_ptr<BlockSource> openTableSource(const std::string& file,
+                                             const std::string& table_type,
+                                             size_t block_size, Statistics* stats,
+                                             size_t parse_threads) {
+    if (isExternalTable(file)) {
+        return std::unique_ptr<BlockSource>(
+            new ExternalTableReader(file, table_type, block_size, stats, parse_threads));
+    }
+    return std::unique_ptr<BlockSource>(new TableReader(file, block_size, stats));
+}
+
+size_t estimateTableBlocks(const std::string& file, const std::string& table_type,
+                           size_t block_size) {
+    if (isExternalTable(file)) {
+        return ExternalTableReader(file, table_type, block_size).estimateBlockCount();
+    }
+    struct stat st_buf;
+    if (::stat(file.c_str(), &st_buf) != 0) {
+        throw std::runtime_error("Failed to open file: " + file);
+    }
+    return static_cast<size_t>(st_buf.st_size) / block_size;
+}
+
+// ============================================================================
+// 페이지 색인 공유 캐시
+// ============================================================================
+
+struct CachedPageIndex {
+    uint64_t file_size;
+    int64_t file_mtime_ns;
+    std::shared_ptr<const std::vector<uint64_t>> pages;
+};
+
+static std::mutex index_cache_mutex;
+static std::map<std::string, CachedPageIndex> index_cache;
+
+// ============================================================================
+// ExternalTableReader 구현
+// ============================================================================
+
+ExternalTableReader::ExternalTableReader(const std::string& fname, const std::string& type,
+                                         size_t blk_size, Statistics* st, size_t threads)
+    : filename(fname),
+      table_type(type),
+      block_size(blk_size),
+      stats(st),
+      parse_threads(resolveThreadCount(threads > 0 ? threads : external_parse_threads)),
+      fd(-1),
+      file_size(0),
+      file_mtime_ns(0),
+      read_offset(0),
+      chunk_size(MIN_CHUNK_SIZE),
+      current_record(0),
+      current_data(nullptr),
+      has_current(false),
+      next_page(0),
+      reported_offset(0),
+      publish_index(true) {
+
+    // 알 수 없는 타입이면 여기서 예외
+    TBLParser::legacyParserFor(table_type);
+
+    fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open TBL file: " + filename);
+    }
+
+    struct stat st_buf;
+    if (fstat(fd, &st_buf) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + filename);
+    }
+    file_size = static_cast<uint64_t>(st_buf.st_size);
+    file_mtime_ns = static_cast<int64_t>(st_buf.st_mtim.tv_sec) * 1000000000LL +
+                    st_buf.st_mtim.tv_nsec;
+}
+
+ExternalTableReader::~ExternalTableReader() {
+    // 진행 중인 파싱 작업이 끝날 때까지 대기 (future 소멸자)
+    pending.clear();
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+ExternalTableReader::ParsedChunk ExternalTableReader::parseChunk(uint64_t base, uint64_t end,
+                                                                 const std::string& type,
+                                                                 const std::string& text) {
+    ParsedChunk chunk;
+    chunk.base = base;
+    chunk.end = end;
+    TBLParser parser(type);
+    parser.parseChunk(text.data(), text.size(), chunk.parsed);
+    return chunk;
+}
+
+uint64_t ExternalTableReader::readChunkText(uint64_t offset, size_t size,
+                                            std::string& text) const {
+    while (true) {
+        size_t want = static_cast<size_t>(std::min<uint64_t>(size, file_size - offset));
+        text.resize(want);
+
+        size_t done = 0;
+        while (done < want) {
+            ssize_t n = pread(fd, &text[done], want - done, static_cast<off_t>(offset + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                throw std::runtime_error("Read error on " + filename + ": " + std::strerror(errno));
+            }
+            if (n == 0) break;
+            done += static_cast<size_t>(n);
+        }
+        text.resize(done);
+
+        // 파일 끝까지 읽었으면 줄바꿈 없이 끝나는 마지막 줄 포함
+        if (offset + done >= file_size || done < want) {
+            return offset + done;
+        }
+
+        // 마지막 줄바꿈 뒤의 미완성 줄은 다음 청크로
+        size_t last_newline = text.rfind('\n');
+        if (last_newline != std::string::npos) {
+            text.resize(last_newline + 1);
+            return offset + last_newline + 1;
+        }
+
+        // 청크보다 긴 줄
+        size *= 2;
+    }
+}
+
+void ExternalTableReader::fillPending() {
+    while (pending.size() < parse_threads && read_offset < file_size) {
+        std::string text;
+        uint64_t base = read_offset;
+        read_offset = readChunkText(base, chunk_size, text);
+        chunk_size = std::min(chunk_size * 2, MAX_CHUNK_SIZE);
+
+        pending.push_back(std::async(std::launch::async, &ExternalTableReader::parseChunk,
+                                     base, read_offset, table_type, std::move(text)));
+    }
+}
+
+bool ExternalTableReader::nextChunk() {
+    fillPending();
+    if (pending.empty()) {
+        has_current = false;
+        return false;
+    }
+
+    current = pending.front().get();
+    pending.pop_front();
+    fillPending();
+
+    // 같은 구간을 다시 스캔할 때는 파싱 오류를 반복 출력하지 않음
+    if (current.base >= reported_offset) {
+        for (const std::string& error : current.parsed.errors) {
+            std::cerr << error << std::endl;
+        }
+        reported_offset = current.end;
+    }
+
+    current_record = 0;
+    current_data = current.parsed.encoded.data();
+    has_current = true;
+    return true;
+}
+
+void ExternalTableReader::seek(uint64_t offset, size_t page) {
+    pending.clear();
+    has_current = false;
+    read_offset = offset;
+    chunk_size = MIN_CHUNK_SIZE;
+    next_page = page;
+
+    // 색인은 0번 페이지부터 끊김 없이 스캔할 때만 쌓음
+    if (!index) {
+        building.resize(std::min(building.size(), page));
+    }
+}
+
+bool ExternalTableReader::fillPage(Block* block) {
+    block->clear();
+    bool started = false;
+
+    while (true) {
+        if (!has_current || current_record == current.parsed.sizes.size()) {
+            if (!nextChunk()) break;
+            continue;
+        }
+
+        uint32_t size = current.parsed.sizes[current_record];
+        if (!started && !index && next_page == building.size()) {
+            building.push_back(current.base + current.parsed.line_offsets[current_record]);
+        }
+
+        if (!block->append(current_data, size)) {
+            if (!started) {
+                throw std::runtime_error("Record too large for block in " + filename);
+            }
+            break;
+        }
+        started = true;
+        current_data += size;
+        current_record++;
+    }
+
+    if (!started) {
+        // 0번 페이지부터 끝까지 스캔했으면 색인 완성
+        if (!index && next_page == building.size()) {
+            index = std::make_shared<const PageIndex>(std::move(building));
+            building.clear();
+            if (publish_index) {
+                std::lock_guard<std::mutex> lock(index_cache_mutex);
+                CachedPageIndex cached = {file_size, file_mtime_ns, index};
+                index_cache[cacheKey()] = cached;
+            }
+        }
+        return false;
+    }
+
+    next_page++;
+    if (stats) {
+        stats->block_reads++;
+    }
+    return true;
+}
+
+std::string ExternalTableReader::cacheKey() const {
+    return filename + '\0' + table_type + '\0' + std::to_string(block_size);
+}
+
+const ExternalTableReader::PageIndex& ExternalTableReader::loadIndex() const {
+    if (index) {
+        return *index;
+    }
+
+    // 여러 스레드가 동시에 요청해도 색인 스캔은 한 번만
+    std::lock_guard<std::mutex> lock(index_cache_mutex);
+    auto it = index_cache.find(cacheKey());
+    if (it != index_cache.end() && it->second.file_size == file_size &&
+        it->second.file_mtime_ns == file_mtime_ns) {
+        index = it->second.pages;
+        return *index;
+    }
+
+    // 별도 리더로 끝까지 스캔 (이 리더의 스캔 위치는 그대로)
+    ExternalTableReader scanner(filename, table_type, block_size, nullptr, parse_threads);
+    scanner.publish_index = false;
+    scanner.reported_offset = UINT64_MAX;
+    Block block(block_size);
+    while (scanner.fillPage(&block)) {
+    }
+
+    index = scanner.index;
+    CachedPageIndex cached = {file_size, file_mtime_ns, index};
+    index_cache[cacheKey()] = cached;
+    return *index;
+}
+
+bool ExternalTableReader::readBlock(Block* block) {
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while reading " + filename);
+    }
+    return fillPage(block);
+}
+
+bool ExternalTableReader::readBlockAt(size_t page_no, Block* block) {
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while reading " + filename);
+    }
+
+    // 바로 다음 페이지면 순차 스캔을 이어감
+    if (page_no != next_page) {
+        const PageIndex& pages = loadIndex();
+        if (page_no >= pages.size()) {
+            return false;
+        }
+        seek(pages[page_no], page_no);
+    }
+    return fillPage(block);
+}
+
+void ExternalTableReader::reset() {
+    if (next_page != 0 || has_current || read_offset != 0) {
+        seek(0, 0);
+    }
+}
+
+size_t ExternalTableReader::getBlockCount() const {
+    return loadIndex().size();
+}
+
+size_t ExternalTableReader::estimateBlockCount() const {
+    if (!index) {
+        std::lock_guard<std::mutex> lock(index_cache_mutex);
+        auto it = index_cache.find(cacheKey());
+        if (it != index_cache.end() && it->second.file_size == file_size &&
+            it->second.file_mtime_ns == file_mtime_ns) {
+            index = it->second.pages;
+        }
+    }
+    if (index) {
+        return index->size();
+    }
+    uint64_t bytes = file_size / 100 * TBL_PAGE_ESTIMATE_PERCENT;
+    return static_cast<size_t>((bytes + block_size - 1) / block_size);
+}
@@ -1,4 +1,5 @@
 #include "file_manager.h"
+#include "table_metadata.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -87,8 +88,10 @@ size_t FileManager::convertCSV(const std::string& csv_file,
 // ============================================================================
 
 size_t FileManager::readBlockFile(const std::string& block_file,
+                                  const std::string& table_type,
                                   std::function<void(const Record&)> callback) {
     try {
+        const Schema* schema = &Schema::forTable(table_type);
         TableReader reader(block_file, block_size, &stats);
 
         if (!reader.isOpen()) {
@@ -100,11 +103,11 @@ size_t FileManager::readBlockFile(const std::string& block_file,
 
         // 모든 블록 읽기
         while (reader.readBlock(&block)) {
-            RecordReader rec_reader(&block);
+            RecordReader rec_reader(&block, schema);
 
             // 블록의 모든 레코드 읽기
             while (rec_reader.hasNext()) {
-                Record record = rec_reader.readNext();
+                Record record = rec_reader.readNext().materialize();
                 callback(record);
                 record_count++;
             }
@@ -119,7 +122,7 @@ size_t FileManager::readBlockFile(const std::string& block_file,
 
 size_t FileManager::readPartRecords(const std::string& block_file,
                                     std::function<void(const PartRecord&)> callback) {
-    return readBlockFile(block_file, [&callback](const Record& record) {
+    return readBlockFile(block_file, "PART", [&callback](const Record& record) {
         try {
             PartRecord part = PartRecord::fromRecord(record);
             callback(part);
@@ -131,7 +134,7 @@ size_t FileManager::readPartRecords(const std::string& block_file,
 
 size_t FileManager::readPartSuppRecords(const std::string& block_file,
                                         std::function<void(const PartSuppRecord&)> callback) {
-    return readBlockFile(block_file, [&callback](const Record& record) {
+    return readBlockFile(block_file, "PARTSUPP", [&callback](const Record& record) {
         try {
             PartSuppRecord partsupp = PartSuppRecord::fromRecord(record);
             callback(partsupp);
@@ -289,17 +292,36 @@ size_t FileManager::getMemoryUsage() const {
 // ============================================================================
 
 size_t FileManager::countRecords(const std::string& block_file) {
-    size_t count = 0;
+    try {
+        // 메타데이터가 있으면 스캔 없이
+        TableMetadata meta;
+        if (TableMetadata::load(block_file, meta)) {
+            return meta.record_count;
+        }
 
-    readBlockFile(block_file, [&count](const Record&) {
-        count++;
-    });
+        TableReader reader(block_file, block_size, &stats);
+        Block block(block_size);
+        size_t count = 0;
+
+        // 페이지 헤더의 레코드 수만 합산 (행 디코딩 불필요)
+        while (reader.readBlock(&block)) {
+            count += block.getRecordCount();
+        }
 
-    return count;
+        return count;
+
+    } catch (const std::exception& e) {
+        throw std::runtime_error("countRecords failed: " + std::string(e.what()));
+    }
 }
 
 size_t FileManager::countBlocks(const std::string& block_file) {
     try {
+        TableMetadata meta;
+        if (TableMetadata::load(block_file, meta) && meta.block_size == block_size) {
+            return meta.block_count;
+        }
+
         Statistics local_stats;
         TableReader reader(block_file, block_size, &local_stats);
 
@@ -354,6 +376,24 @@ void FileManager::printFileInfo(const std::string& block_file) {
                   << (file_size > 0 ? (num_blocks * block_size * 100.0) / file_size : 0.0)
                   << "%" << std::endl;
 
+        // 메타데이터: 테이블 타입과 숫자 컬럼 범위
+        TableMetadata meta;
+        if (TableMetadata::load(block_file, meta)) {
+            const Schema& schema = meta.getSchema();
+            std::cout << std::setw(20) << "Table Type: " << meta.table_type << std::endl;
+            std::cout << std::setw(20) << "Record Bytes: " << meta.record_bytes << std::endl;
+            std::cout << std::defaultfloat << std::setprecision(7);
+            for (size_t i = 0; i < schema.getColumnCount(); ++i) {
+                const ColumnRange& range = meta.ranges[i];
+                if (!range.valid) continue;
+                std::cout << std::setw(18) << schema.getColumn(i).name << ": ["
+                          << range.min << ", " << range.max << "]" << std::endl;
+            }
+        } else {
+            std::cout << std::setw(20) << "Table Type: " << "unknown (no current "
+                      << TableMetadata::pathFor(block_file) << ")" << std::endl;
+        }
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }
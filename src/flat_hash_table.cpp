@@ -0,0 +1,107 @@
+#include "flat_hash_table.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+const uint32_t FlatHashTable::NONE;
+const double FlatHashTable::MAX_LOAD = 0.7;
+
+// 최소 슬롯 수 (2의 거듭제곱)
+static const size_t MIN_CAPACITY = 16;
+
+FlatHashTable::FlatHashTable() : mask(0), shift(32), key_count(0) {
+    rehash(MIN_CAPACITY);
+}
+
+void FlatHashTable::rehash(size_t capacity) {
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < capacity) {
+        bits++;
+    }
+    if (bits > 31) {
+        throw std::runtime_error("Hash table too large: " + std::to_string(capacity) + " slots");
+    }
+
+    std::vector<Slot> old_slots(static_cast<size_t>(1) << bits, Slot{0, NONE});
+    old_slots.swap(slots);
+    mask = slots.size() - 1;
+    shift = 32 - bits;
+
+    for (const Slot& slot : old_slots) {
+        if (slot.head == NONE) continue;
+
+        size_t i = slotOf(slot.key);
+        while (slots[i].head != NONE) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+}
+
+void FlatHashTable::reserve(size_t records, size_t payload_bytes) {
+    entries.reserve(records);
+    arena.reserve(payload_bytes);
+
+    size_t capacity = slots.size();
+    while (static_cast<double>(records) > capacity * MAX_LOAD) {
+        capacity *= 2;
+    }
+    if (capacity != slots.size()) {
+        rehash(capacity);
+    }
+}
+
+void FlatHashTable::insert(int_t key, const char* data, size_t size) {
+    if (size > UINT32_MAX || entries.size() >= NONE) {
+        throw std::runtime_error("Hash table exceeds 2^32 records");
+    }
+
+    // 레코드 바이트를 arena에 복사
+    char* dest = arena.allocate(size);
+    std::memcpy(dest, data, size);
+    Entry entry;
+    entry.data = dest;
+    entry.size = static_cast<uint32_t>(size);
+    entry.next = NONE;
+
+    uint32_t index = static_cast<uint32_t>(entries.size());
+
+    // 키 슬롯 찾기 (없으면 빈 슬롯에 새로 등록)
+    size_t i = slotOf(key);
+    while (slots[i].head != NONE && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+
+    if (slots[i].head == NONE) {
+        if (static_cast<double>(key_count + 1) > slots.size() * MAX_LOAD) {
+            rehash(slots.size() * 2);
+            i = slotOf(key);
+            while (slots[i].head != NONE) {
+                i = (i + 1) & mask;
+            }
+        }
+        slots[i].key = key;
+        key_count++;
+    } else {
+        // 같은 키의 기존 체인 앞에 연결
+        entry.next = slots[i].head;
+    }
+
+    slots[i].head = index;
+    entries.push_back(entry);
+}
+
+void FlatHashTable::clear() {
+    for (Slot& slot : slots) {
+        slot.head = NONE;
+    }
+    entries.clear();
+    arena.rewind();
+    key_count = 0;
+}
+
+void FlatHashTable::release() {
+    clear();
+    std::vector<Entry>().swap(entries);
+    arena.release();
+}
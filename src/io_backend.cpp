@@ -0,0 +1,241 @@
+#include "io_backend.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// ============================================================================
+// 백엔드 이름 / 기본 설정
+// ============================================================================
+
+static IoOptions default_io_options;
+
+IoBackend parseIoBackend(const std::string& name) {
+    if (name == "stream") return IoBackend::STREAM;
+    if (name == "pread") return IoBackend::PREAD;
+    if (name == "uring") return IoBackend::URING;
+    throw std::runtime_error("Unknown I/O backend: " + name);
+}
+
+const char* ioBackendName(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::PREAD: return "pread";
+        case IoBackend::URING: return "uring";
+        default:               return "stream";
+    }
+}
+
+void setDefaultIoOptions(const IoOptions& options) {
+    default_io_options = options;
+}
+
+const IoOptions& getDefaultIoOptions() {
+    return default_io_options;
+}
+
+IoOptions resolveIoOptions(const IoOptions& requested, size_t block_size) {
+    IoOptions resolved = requested;
+
+    if (resolved.backend == IoBackend::URING && !IoUring::isSupported()) {
+        static bool warned = false;
+        if (!warned) {
+            std::cerr << "Warning: io_uring unavailable, falling back to pread" << std::endl;
+            warned = true;
+        }
+        resolved.backend = IoBackend::PREAD;
+    }
+
+    // O_DIRECT는 fd 기반 백엔드에서만, 섹터(512 bytes) 배수 크기로만 가능
+    if (resolved.direct && (resolved.backend == IoBackend::STREAM || block_size % 512 != 0)) {
+        static bool warned = false;
+        if (!warned) {
+            std::cerr << "Warning: O_DIRECT needs --io-backend pread|uring and a block size "
+                         "that is a multiple of 512; using buffered I/O" << std::endl;
+            warned = true;
+        }
+        resolved.direct = false;
+    }
+
+    if (resolved.queue_depth == 0) {
+        resolved.queue_depth = 1;
+    }
+    return resolved;
+}
+
+IoOptions limitQueueDepth(const IoOptions& options, size_t depth) {
+    IoOptions limited = options;
+    if (limited.backend == IoBackend::URING) {
+        if (depth == 0) {
+            limited.backend = IoBackend::PREAD;
+        } else {
+            limited.queue_depth = std::min(limited.queue_depth, depth);
+        }
+    }
+    return limited;
+}
+
+// ============================================================================
+// io_uring 래퍼
+// ============================================================================
+
+static int sysIoUringSetup(unsigned entries, struct io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int sysIoUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                                    nullptr, 0));
+}
+
+bool IoUring::isSupported() {
+    static int supported = -1;
+    if (supported < 0) {
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = sysIoUringSetup(1, &params);
+        supported = fd >= 0 ? 1 : 0;
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    return supported == 1;
+}
+
+IoUring::IoUring(unsigned queue_entries)
+    : ring_fd(-1), entries(0),
+      sq_ptr(MAP_FAILED), sq_map_size(0),
+      cq_ptr(MAP_FAILED), cq_map_size(0),
+      sqe_ptr(MAP_FAILED), sqe_map_size(0),
+      pending(0) {
+
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = sysIoUringSetup(queue_entries, &params);
+    if (ring_fd < 0) {
+        throw std::runtime_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+    }
+    entries = params.sq_entries;
+
+    // SQ/CQ 링 매핑 (SINGLE_MMAP이면 한 영역을 공유)
+    sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_map_size = cq_map_size = std::max(sq_map_size, cq_map_size);
+    }
+
+    sq_ptr = mmap(nullptr, sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+        close(ring_fd);
+        throw std::runtime_error("Failed to map io_uring submission queue");
+    }
+
+    if (single_mmap) {
+        cq_ptr = sq_ptr;
+    } else {
+        cq_ptr = mmap(nullptr, cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) {
+            munmap(sq_ptr, sq_map_size);
+            close(ring_fd);
+            throw std::runtime_error("Failed to map io_uring completion queue");
+        }
+    }
+
+    sqe_map_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqe_ptr = mmap(nullptr, sqe_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring_fd, IORING_OFF_SQES);
+    if (sqe_ptr == MAP_FAILED) {
+        if (cq_ptr != sq_ptr) munmap(cq_ptr, cq_map_size);
+        munmap(sq_ptr, sq_map_size);
+        close(ring_fd);
+        throw std::runtime_error("Failed to map io_uring submission entries");
+    }
+
+    char* sq = static_cast<char*>(sq_ptr);
+    sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(cq_ptr);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = cq + params.cq_off.cqes;
+}
+
+IoUring::~IoUring() {
+    munmap(sqe_ptr, sqe_map_size);
+    if (cq_ptr != sq_ptr) {
+        munmap(cq_ptr, cq_map_size);
+    }
+    munmap(sq_ptr, sq_map_size);
+    close(ring_fd);
+}
+
+void IoUring::prep(uint8_t opcode, int fd, void* buf, size_t len, off_t offset, uint64_t tag) {
+    unsigned tail = *sq_tail;
+    unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= entries) {
+        throw std::runtime_error("io_uring submission queue full");
+    }
+
+    unsigned index = tail & *sq_mask;
+    struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqe_ptr) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = tag;
+
+    sq_array[index] = index;
+    // SQE 내용이 tail 갱신보다 먼저 보이도록 release
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    pending++;
+}
+
+void IoUring::prepRead(int fd, void* buf, size_t len, off_t offset, uint64_t tag) {
+    prep(IORING_OP_READ, fd, buf, len, offset, tag);
+}
+
+void IoUring::prepWrite(int fd, const void* buf, size_t len, off_t offset, uint64_t tag) {
+    prep(IORING_OP_WRITE, fd, const_cast<void*>(buf), len, offset, tag);
+}
+
+void IoUring::submit(unsigned wait_nr) {
+    unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        int ret = sysIoUringEnter(ring_fd, pending, wait_nr, flags);
+        if (ret >= 0) {
+            pending -= std::min(pending, static_cast<unsigned>(ret));
+            return;
+        }
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+        }
+    }
+}
+
+bool IoUring::popCompletion(uint64_t& tag, int& result) {
+    unsigned head = *cq_head;
+    if (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    const struct io_uring_cqe* cqe =
+        static_cast<const struct io_uring_cqe*>(cqes) + (head & *cq_mask);
+    tag = cqe->user_data;
+    result = cqe->res;
+
+    __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
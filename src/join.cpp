@@ -1,6 +1,15 @@
 #include "join.h"
+#include "external_table_reader.h"
+#include "mapped_table_reader.h"
+#include "parallel.h"
+#include "prefetch_reader.h"
+#include "write_behind_writer.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 /**
@@ -23,8 +32,68 @@
  *   - Outer 버퍼: B-1 블록
  *   - Inner 버퍼: 1 블록
  *   - Output 버퍼: 별도 관리
+ *
+ * 청크 매칭 방식 (I/O와 버퍼 사용량은 동일, CPU 비용만 다름):
+ *   - NESTED_LOOP: inner 블록마다 O(|chunk| × |block|) 키 비교 (SIMD)
+ *   - HASH: outer 청크마다 해시 인덱스를 만들고 inner 레코드당 1회 조회,
+ *           inner 블록마다 O(|block|)
+ *
+ * 병렬 실행 (threads = T > 1):
+ *   - 총 버퍼 B개 중 T개를 스레드별 inner 버퍼로, 나머지 B-T개를 outer 청크로 사용
+ *   - 청크마다 inner 파일을 T개의 연속 블록 구간으로 나누고, 각 스레드가 자기
+ *     구간만 스캔하며 공유 outer 청크(키 배열, 해시 인덱스)를 읽기 전용으로 참조
+ *   - I/O 총량은 순차 버전과 같고, outer 청크가 T-1 블록 작아지는 만큼 inner
+ *     스캔 횟수가 늘 수 있음
+ *
+ * 미리 읽기 (prefetch_depth = D > 0):
+ *   - outer/inner 리더마다 I/O 스레드가 D개 블록을 앞서 읽어 두어 디스크 읽기와
+ *     키 매칭이 겹침 (버퍼 예산 B와 별도로 리더당 D 블록 사용)
+ *
+ * mmap 스캔 (outer_scan / inner_scan = MMAP):
+ *   - 파일을 매핑하고 버퍼 블록을 매핑된 페이지의 뷰로 바꿔 복사 없이 조인
+ *   - 반복되는 inner 스캔은 페이지 캐시에서 바로 읽힘 (미리 읽기보다 우선)
  */
 
+// ============================================================================
+// ChunkHashIndex 구현
+// ============================================================================
+const uint32_t ChunkHashIndex::EMPTY;
+
+void ChunkHashIndex::build(const int_t* key_data, size_t n) {
+    keys = key_data;
+
+    // 버킷 수: 항목 수의 2배 이상인 2의 거듭제곱
+    size_t bucket_bits = 1;
+    while ((static_cast<size_t>(1) << bucket_bits) < 2 * n) {
+        bucket_bits++;
+    }
+    shift = 32 - bucket_bits;
+
+    heads.assign(static_cast<size_t>(1) << bucket_bits, EMPTY);
+    next.resize(n);
+
+    // 역순으로 삽입하여 체인이 outer 인덱스 오름차순이 되도록 함
+    for (size_t i = n; i-- > 0;) {
+        size_t b = bucketOf(keys[i]);
+        next[i] = heads[b];
+        heads[b] = static_cast<uint32_t>(i);
+    }
+}
+
+void ChunkHashIndex::probeBlock(const int_t* inner_keys, size_t inner_n,
+                                SelectionVector& sel) const {
+    for (size_t j = 0; j < inner_n; ++j) {
+        int_t key = inner_keys[j];
+
+        for (uint32_t i = heads[bucketOf(key)]; i != EMPTY; i = next[i]) {
+            if (keys[i] == key) {
+                sel.outer_idx.push_back(i);
+                sel.inner_idx.push_back(static_cast<uint32_t>(j));
+            }
+        }
+    }
+}
+
 // ============================================================================
 // 생성자: 조인 파라미터 초기화 및 검증
 // ============================================================================
@@ -44,7 +113,27 @@ BlockNestedLoopsJoin::BlockNestedLoopsJoin(
       inner_table_type(inner_type),
       join_key(join_key_name),
       buffer_size(buf_size),
-      block_size(blk_size) {
+      block_size(blk_size),
+      outer_schema(&Schema::forTable(outer_type)),
+      inner_schema(&Schema::forTable(inner_type)),
+      output_schema(Schema::concat(*outer_schema, *inner_schema)),
+      outer_key_col(outer_schema->getKeyColumn(join_key_name)),
+      inner_key_col(inner_schema->getKeyColumn(join_key_name)),
+      match_kernel(KeyMatcher::detectKernel()),
+      match_mode(ChunkMatchMode::NESTED_LOOP),
+      chunk_index_memory(0),
+      num_threads(1),
+      prefetch_depth(0),
+      outer_scan(ScanMethod::READ),
+      inner_scan(ScanMethod::READ),
+      write_behind_blocks(0),
+      parse_memory(0),
+      output_write_calls(0),
+      output_stall_time(0.0),
+      use_zone_maps(true),
+      inner_zone_slot(0),
+      inner_pool_frames(0),
+      inner_pool_policy(ReplacementPolicy::MRU) {
 
     // 버퍼 크기 검증: 최소 2개 필요 (outer 1개 + inner 1개)
     if (buffer_size < 2) {
@@ -68,9 +157,39 @@ void BlockNestedLoopsJoin::execute() {
     stats.elapsed_time = elapsed.count();
 
     // ========== 단계 4: 메모리 사용량 계산 ==========
-    // 총 메모리 = 버퍼 개수 × 블록 크기
+    // 총 메모리 = 버퍼 개수 × 블록 크기 (병렬 실행과 inner 버퍼 풀도 같은 버퍼 예산을 나눠 씀)
     stats.memory_usage = buffer_size * block_size;
 
+    // 미리 읽기 링 (read 스캔인 outer 리더 1개 + inner 리더 스레드 수만큼)
+    if (prefetch_depth > 0) {
+        size_t readers = (outer_scan == ScanMethod::READ ? 1 : 0) +
+                         (inner_scan == ScanMethod::READ && inner_pool_frames == 0
+                              ? std::max<size_t>(1, thread_stats.size()) : 0);
+        stats.memory_usage += readers * prefetch_depth * block_size;
+    }
+
+    // write-behind 출력 풀
+    stats.memory_usage += write_behind_blocks * block_size;
+
+    // io_uring 창 (read 스캔 리더: outer 1개 + inner 스레드 수만큼, 동기 출력 라이터 1개)
+    size_t window = ioWindowBlocks(getDefaultIoOptions());
+    if (window > 0) {
+        size_t readers =
+            (outer_scan == ScanMethod::READ && !isExternalTable(outer_table_file) ? 1 : 0) +
+            (inner_scan == ScanMethod::READ && !isExternalTable(inner_table_file)
+                 ? std::max<size_t>(1, thread_stats.size()) : 0);
+        size_t writers = write_behind_blocks > 0 ? 0 : 1;
+        stats.memory_usage += (readers + writers) * window * block_size;
+    }
+
+    // .tbl 입력의 파싱 버퍼 (리더마다 앞서 파싱 중인 청크, --parse-threads에 비례)
+    stats.memory_usage += parse_memory;
+
+    // 작업자별 inner 읽기/출력 통계를 전체 통계에 합산
+    for (const Statistics& local : thread_stats) {
+        stats.merge(local);
+    }
+
     // ========== 단계 5: 성능 통계 출력 ==========
     std::cout << "\n=== Join Statistics ===" << std::endl;
     std::cout << "Block Reads: " << stats.block_reads << std::endl;
@@ -79,6 +198,79 @@ void BlockNestedLoopsJoin::execute() {
     std::cout << "Elapsed Time: " << stats.elapsed_time << " seconds" << std::endl;
     std::cout << "Memory Usage: " << stats.memory_usage << " bytes ("
               << (stats.memory_usage / 1024.0 / 1024.0) << " MB)" << std::endl;
+    if (match_mode == ChunkMatchMode::HASH) {
+        std::cout << "Match Mode: chunk hash (index "
+                  << (chunk_index_memory / 1024.0) << " KB)" << std::endl;
+    } else {
+        std::cout << "Match Mode: nested loop (kernel "
+                  << KeyMatcher::kernelName(match_kernel) << ")" << std::endl;
+    }
+    if (outer_scan == ScanMethod::MMAP || inner_scan == ScanMethod::MMAP) {
+        std::cout << "Scan: outer " << (outer_scan == ScanMethod::MMAP ? "mmap" : "read")
+                  << ", inner " << (inner_scan == ScanMethod::MMAP ? "mmap" : "read")
+                  << std::endl;
+    }
+    if (prefetch_depth > 0) {
+        std::cout << "Prefetch Depth: " << prefetch_depth << " blocks per reader" << std::endl;
+        std::cout << "I/O Stall Time: " << stats.io_stall_time << " seconds" << std::endl;
+    }
+    if (write_behind_blocks > 0) {
+        std::cout << "Write-Behind: " << write_behind_blocks << " pool blocks, "
+                  << output_write_calls << " pwritev calls ("
+                  << (output_write_calls > 0
+                          ? static_cast<double>(stats.block_writes) / output_write_calls : 0.0)
+                  << " blocks/call)" << std::endl;
+        std::cout << "Output Stall Time: " << output_stall_time << " seconds" << std::endl;
+    }
+    if (inner_zones) {
+        std::cout << "Zone Map: " << stats.blocks_skipped << " inner blocks skipped" << std::endl;
+    }
+    if (inner_pool_frames > 0) {
+        size_t requests = stats.buffer_hits + stats.buffer_misses;
+        std::cout << "Inner Buffer Pool: " << inner_pool_frames << " frames ("
+                  << replacementPolicyName(inner_pool_policy) << "), "
+                  << stats.buffer_hits << " hits / " << stats.buffer_misses << " misses ("
+                  << std::fixed << std::setprecision(1)
+                  << (requests > 0 ? 100.0 * stats.buffer_hits / requests : 0.0)
+                  << "% hit rate)" << std::endl;
+        std::cout << std::defaultfloat << std::setprecision(6);
+    }
+
+    if (!thread_stats.empty()) {
+        std::cout << "\nThread  Block Reads  Output Records" << std::endl;
+        for (size_t t = 0; t < thread_stats.size(); ++t) {
+            std::cout << std::setw(6) << t << std::setw(13) << thread_stats[t].block_reads
+                      << std::setw(16) << thread_stats[t].output_records << std::endl;
+        }
+    }
+}
+
+// ============================================================================
+// 입력 리더 생성: 외부 테이블 / mmap 뷰 / 미리 읽기 / 동기 읽기
+// ============================================================================
+std::unique_ptr<BlockSource> BlockNestedLoopsJoin::openScan(const std::string& file,
+                                                           ScanMethod method,
+                                                           Statistics* read_stats,
+                                                           bool allow_prefetch) {
+    if (isExternalTable(file)) {
+        // 병렬 BNLJ의 inner는 스레드마다 리더를 열므로 리더당 파싱 작업 하나만 앞서 돌림
+        bool outer = (file == outer_table_file);
+        size_t parse_threads = (!outer && num_threads > 1) ? 1 : 0;
+        ExternalTableReader* reader = new ExternalTableReader(
+            file, outer ? outer_table_type : inner_table_type, block_size, read_stats,
+            parse_threads);
+        parse_memory += reader->getMemoryUsage();
+        return std::unique_ptr<BlockSource>(reader);
+    }
+    if (method == ScanMethod::MMAP) {
+        return std::unique_ptr<BlockSource>(
+            new MappedTableReader(file, block_size, read_stats, map_options));
+    }
+    if (prefetch_depth > 0 && allow_prefetch) {
+        return std::unique_ptr<BlockSource>(
+            new PrefetchReader(file, block_size, prefetch_depth, read_stats));
+    }
+    return std::unique_ptr<BlockSource>(new TableReader(file, block_size, read_stats));
 }
 
 // ============================================================================
@@ -87,107 +279,102 @@ void BlockNestedLoopsJoin::execute() {
 void BlockNestedLoopsJoin::performJoin() {
     // ========== 단계 1: 파일 리더/라이터 생성 ==========
     // 통계 객체를 전달하여 I/O 카운트 자동 추적
-    TableReader outer_reader(outer_table_file, block_size, &stats);
-    TableReader inner_reader(inner_table_file, block_size, &stats);
-    TableWriter writer(output_file, &stats);
+    std::unique_ptr<BlockSource> outer_reader = openScan(outer_table_file, outer_scan, &stats);
+    std::unique_ptr<BlockSource> inner_reader =
+        openScan(inner_table_file, inner_scan, &stats, inner_pool_frames == 0);
+    // write-behind이면 가득 찬 출력 블록을 백그라운드 스레드가 모아서 기록
+    std::unique_ptr<BlockSink> writer;
+    WriteBehindWriter* write_behind = nullptr;
+    if (write_behind_blocks > 0) {
+        write_behind = new WriteBehindWriter(output_file, block_size, write_behind_blocks, &stats);
+        writer.reset(write_behind);
+    } else {
+        writer.reset(new TableWriter(output_file, &stats));
+    }
+
+    // inner 페이지별 키 범위 (convert가 기록한 .dat.zones, 조인 키를 기록한 경우만)
+    inner_zones.reset();
+    if (use_zone_maps) {
+        std::shared_ptr<const ZoneMap> zones = ZoneMap::load(inner_table_file, block_size);
+        int slot = zones ? zones->findSlot(inner_key_col) : -1;
+        if (slot >= 0) {
+            inner_zones = zones;
+            inner_zone_slot = static_cast<size_t>(slot);
+        }
+    }
 
     // ========== 단계 2: 버퍼 풀 생성 ==========
     // buffer_size 개의 블록을 사전 할당
-    BufferManager buffer_mgr(buffer_size, block_size);
+    // (inner 버퍼 풀을 쓰면 풀 프레임이 inner 버퍼를 대신하므로 나머지가 모두 outer용)
+    size_t thread_count = std::min(num_threads, buffer_size - 1);
+    size_t pool_frames = innerPoolFrames(thread_count);
+    if (pool_frames >= buffer_size) {
+        throw std::runtime_error("Inner buffer pool of " + std::to_string(pool_frames) +
+                                 " frames leaves no outer buffer within " +
+                                 std::to_string(buffer_size) + " blocks");
+    }
+    BufferManager buffer_mgr(buffer_size - pool_frames, block_size);
 
     // ========== 단계 3: 일반화된 조인 수행 ==========
-    joinTables(outer_reader, inner_reader, writer, buffer_mgr);
-}
+    // 스레드마다 inner 버퍼가 하나씩 필요하므로 outer 버퍼가 최소 1개 남도록 제한
+    if (thread_count > 1) {
+        joinTablesParallel(*outer_reader, *writer, buffer_mgr);
+    } else {
+        joinTables(*outer_reader, *inner_reader, *writer, buffer_mgr);
+    }
 
-// ============================================================================
-// 레코드에서 조인 키 값 추출
-// ============================================================================
-int_t BlockNestedLoopsJoin::getJoinKeyValue(const Record& rec, const std::string& table_type) {
-    if (table_type == "PART") {
-        PartRecord part = PartRecord::fromRecord(rec);
-        if (join_key == "partkey") {
-            return part.partkey;
-        }
-    } else if (table_type == "PARTSUPP") {
-        PartSuppRecord partsupp = PartSuppRecord::fromRecord(rec);
-        if (join_key == "partkey") {
-            return partsupp.partkey;
-        } else if (join_key == "suppkey") {
-            return partsupp.suppkey;
-        }
-    } else if (table_type == "SUPPLIER") {
-        SupplierRecord supplier = SupplierRecord::fromRecord(rec);
-        if (join_key == "suppkey") {
-            return supplier.suppkey;
-        } else if (join_key == "nationkey") {
-            return supplier.nationkey;
-        }
-    } else if (table_type == "CUSTOMER") {
-        CustomerRecord customer = CustomerRecord::fromRecord(rec);
-        if (join_key == "custkey") {
-            return customer.custkey;
-        } else if (join_key == "nationkey") {
-            return customer.nationkey;
-        }
-    } else if (table_type == "ORDERS") {
-        OrdersRecord orders = OrdersRecord::fromRecord(rec);
-        if (join_key == "orderkey") {
-            return orders.orderkey;
-        } else if (join_key == "custkey") {
-            return orders.custkey;
-        }
-    } else if (table_type == "LINEITEM") {
-        LineItemRecord lineitem = LineItemRecord::fromRecord(rec);
-        if (join_key == "orderkey") {
-            return lineitem.orderkey;
-        } else if (join_key == "partkey") {
-            return lineitem.partkey;
-        } else if (join_key == "suppkey") {
-            return lineitem.suppkey;
-        }
-    } else if (table_type == "NATION") {
-        NationRecord nation = NationRecord::fromRecord(rec);
-        if (join_key == "nationkey") {
-            return nation.nationkey;
-        } else if (join_key == "regionkey") {
-            return nation.regionkey;
-        }
-    } else if (table_type == "REGION") {
-        RegionRecord region = RegionRecord::fromRecord(rec);
-        if (join_key == "regionkey") {
-            return region.regionkey;
-        }
+    // ========== 단계 4: 남은 출력 기록 완료 ==========
+    if (write_behind) {
+        write_behind->close();
+        output_write_calls = write_behind->getWriteCalls();
+        output_stall_time = write_behind->getStallTime();
     }
+}
 
-    throw std::runtime_error("Invalid join key '" + join_key + "' for table type '" + table_type + "'");
+size_t BlockNestedLoopsJoin::innerPoolFrames(size_t threads) const {
+    if (inner_pool_frames == 0) {
+        return 0;
+    }
+    threads = std::max<size_t>(1, threads);
+    return std::max<size_t>(1, inner_pool_frames / threads) * threads;
 }
 
 // ============================================================================
-// 두 레코드를 병합하여 조인 결과 생성
+// 청크 키 범위로 inner 페이지 필터 구성
 // ============================================================================
-Record BlockNestedLoopsJoin::mergeRecords(const Record& outer_rec, const Record& inner_rec) {
-    Record result;
-
-    // Outer 레코드의 모든 필드 추가
-    for (size_t i = 0; i < outer_rec.getFieldCount(); ++i) {
-        result.addField(outer_rec.getField(i));
+// inner 페이지의 키 범위가 청크의 [min, max]와 겹치지 않으면 그 페이지의 어떤
+// 레코드도 청크와 매칭될 수 없으므로 읽지도, 키를 추출하지도 않는다.
+PageFilter BlockNestedLoopsJoin::chunkFilter(const std::vector<int_t>& outer_keys) const {
+    if (!inner_zones || outer_keys.empty()) {
+        return PageFilter();
     }
+    auto range = std::minmax_element(outer_keys.begin(), outer_keys.end());
+    return PageFilter(inner_zones, inner_zone_slot, *range.first, *range.second);
+}
 
-    // Inner 레코드의 모든 필드 추가
-    for (size_t i = 0; i < inner_rec.getFieldCount(); ++i) {
-        result.addField(inner_rec.getField(i));
+// ============================================================================
+// 블록에서 레코드 뷰와 조인 키 추출
+// ============================================================================
+// 키 컬럼 인덱스는 생성자에서 한 번만 결정되므로, 레코드마다 고정 오프셋에서
+// int_t 하나를 읽어 연속 배열에 저장한다. (레코드당 1회, |R| + |S|번)
+void BlockNestedLoopsJoin::extractKeys(const Block* block, const Schema* schema, size_t key_col,
+                                       std::vector<RecordView>& records,
+                                       std::vector<int_t>& keys) {
+    RecordReader reader(block, schema);
+    while (reader.hasNext()) {
+        RecordView rec = reader.readNext();
+        keys.push_back(rec.getInt(key_col));
+        records.push_back(rec);
     }
-
-    return result;
 }
 
 // ============================================================================
 // 일반화된 조인 함수: Block Nested Loops Join 알고리즘 구현
 // ============================================================================
 void BlockNestedLoopsJoin::joinTables(
-    TableReader& outer_reader,
-    TableReader& inner_reader,
-    TableWriter& writer,
+    BlockSource& outer_reader,
+    BlockSource& inner_reader,
+    BlockSink& writer,
     BufferManager& buffer_mgr) {
 
     // =========================================================================
@@ -198,14 +385,39 @@ void BlockNestedLoopsJoin::joinTables(
     //   - Inner 테이블용: 1 개 (한 번에 1개 블록만 로드)
     //
     // 이유: Outer 테이블을 많이 로드할수록 Inner 테이블 스캔 횟수 감소
+    // inner 버퍼 풀이 있으면 inner 블록은 풀 프레임이고 buffer_mgr는 모두 outer용 (B - F개)
     // =========================================================================
-    size_t outer_buffer_count = buffer_size - 1;
+    size_t outer_buffer_count =
+        inner_pool_frames > 0 ? buffer_mgr.getBufferCount() : buffer_size - 1;
 
     // ========== 출력 블록 초기화 ==========
     // 조인 결과를 버퍼링하여 디스크 쓰기 횟수 최소화
     Block output_block(block_size);
     RecordWriter output_writer(&output_block);
 
+    // =========================================================================
+    // 조인 키 배열
+    // =========================================================================
+    // Outer 청크와 Inner 블록의 키를 레코드당 한 번씩 추출하여 연속된 int_t
+    // 배열에 저장. 매칭은 키 배열끼리 비교하고, 일치할 때만 레코드에 접근.
+    // 벡터는 청크/블록마다 재사용되므로 용량 확보 후에는 할당이 없음.
+    // =========================================================================
+    std::vector<RecordView> outer_records;  // Outer 레코드 뷰 (outer 버퍼를 직접 참조)
+    std::vector<int_t> outer_keys;          // outer_records[i]의 조인 키
+    std::vector<RecordView> inner_records;
+    std::vector<int_t> inner_keys;
+
+    // 키 비교 커널 / 청크 해시 인덱스와 매칭 쌍을 담는 선택 벡터
+    KeyMatcher matcher(match_kernel);
+    ChunkHashIndex chunk_index;
+    SelectionVector selection;
+
+    // Inner 페이지 버퍼 풀 (설정한 경우, 청크 사이에 유지)
+    std::unique_ptr<BufferPool> inner_pool;
+    if (inner_pool_frames > 0) {
+        inner_pool.reset(new BufferPool(inner_pool_frames, block_size, inner_pool_policy, &stats));
+    }
+
     // =========================================================================
     // Block Nested Loops Join 메인 루프
     // =========================================================================
@@ -217,7 +429,9 @@ void BlockNestedLoopsJoin::joinTables(
         // =====================================================================
         // 단계 1: Outer 테이블 블록들을 버퍼에 로드
         // =====================================================================
-        std::vector<Record> outer_records;  // 메모리에 레코드 저장
+        // 청크 처리 동안 outer 버퍼가 유지되므로 레코드는 복사 없이 뷰로 참조
+        outer_records.clear();
+        outer_keys.clear();
         size_t loaded_blocks = 0;
 
         // (B-1)개 블록을 순차적으로 읽기
@@ -229,11 +443,8 @@ void BlockNestedLoopsJoin::joinTables(
             if (outer_reader.readBlock(outer_block)) {
                 loaded_blocks++;
 
-                // 블록에서 모든 레코드를 추출하여 메모리에 저장
-                RecordReader reader(outer_block);
-                while (reader.hasNext()) {
-                    outer_records.push_back(reader.readNext());
-                }
+                // 블록의 모든 레코드 뷰와 조인 키 수집
+                extractKeys(outer_block, outer_schema, outer_key_col, outer_records, outer_keys);
             } else {
                 // 더 이상 읽을 블록이 없으면 종료
                 break;
@@ -249,76 +460,107 @@ void BlockNestedLoopsJoin::joinTables(
         std::cout << "Loaded " << loaded_blocks << " outer blocks ("
                   << outer_records.size() << " records)" << std::endl;
 
+        // HASH 모드: 청크의 키 배열 위에 해시 인덱스 구성 (청크당 1회)
+        if (match_mode == ChunkMatchMode::HASH) {
+            chunk_index.build(outer_keys.data(), outer_keys.size());
+            if (chunk_index.getMemoryUsage() > chunk_index_memory) {
+                chunk_index_memory = chunk_index.getMemoryUsage();
+            }
+        }
+
         // =====================================================================
         // 단계 2: Inner 테이블을 처음부터 끝까지 스캔
         // =====================================================================
         // 중요: Outer 블록 청크마다 Inner 테이블을 완전히 스캔해야 함
+        // (존 맵이 있으면 청크 키 범위와 겹치지 않는 페이지는 리더가 건너뜀)
+        PageFilter filter = chunkFilter(outer_keys);
+        inner_reader.setPageFilter(filter);
         inner_reader.reset();  // 파일 포인터를 처음으로 되돌림
+        size_t skipped_before = stats.blocks_skipped;
 
-        // Inner 테이블용 버퍼 (마지막 버퍼 사용)
-        Block* inner_block = buffer_mgr.getBuffer(buffer_size - 1);
+        // Inner 테이블용 버퍼 (마지막 버퍼 사용, 버퍼 풀이면 풀 프레임을 쓰므로 없음)
+        Block* inner_block = inner_pool ? nullptr : buffer_mgr.getBuffer(buffer_size - 1);
 
         size_t inner_blocks_scanned = 0;
 
-        // Inner 테이블의 모든 블록 순회
-        while (inner_reader.readBlock(inner_block)) {
+        // Inner 페이지 하나 처리 (리더 버퍼 또는 버퍼 풀 프레임)
+        auto processInner = [&](const Block* inner_page) {
             inner_blocks_scanned++;
 
             // -----------------------------------------------------------------
-            // 단계 2.1: Inner 블록에서 레코드 추출
+            // 단계 2.1: Inner 블록에서 레코드 뷰와 조인 키 추출
             // -----------------------------------------------------------------
-            std::vector<Record> inner_records;
-            RecordReader inner_rec_reader(inner_block);
+            inner_records.clear();
+            inner_keys.clear();
+            extractKeys(inner_page, inner_schema, inner_key_col, inner_records, inner_keys);
 
-            while (inner_rec_reader.hasNext()) {
-                inner_records.push_back(inner_rec_reader.readNext());
+            // -----------------------------------------------------------------
+            // 단계 2.2: 키 매칭
+            // -----------------------------------------------------------------
+            // 일치하는 (outer, inner) 인덱스 쌍을 선택 벡터에 기록
+            //   - NESTED_LOOP: inner 키마다 outer 키 배열 전체를 SIMD 비교
+            //   - HASH: inner 키마다 청크 해시 인덱스 1회 조회
+            selection.clear();
+            if (match_mode == ChunkMatchMode::HASH) {
+                chunk_index.probeBlock(inner_keys.data(), inner_keys.size(), selection);
+            } else {
+                matcher.matchBlock(outer_keys.data(), outer_keys.size(),
+                                   inner_keys.data(), inner_keys.size(), selection);
             }
 
             // -----------------------------------------------------------------
-            // 단계 2.2: 조인 수행 (Nested Loop)
+            // 단계 2.3: 매칭된 쌍만 레코드에 접근하여 출력
             // -----------------------------------------------------------------
-            // Outer 레코드들 × Inner 레코드들 - 모든 쌍 비교
-            for (const auto& outer_rec : outer_records) {
-                for (const auto& inner_rec : inner_records) {
-                    try {
-                        // =============================================================
-                        // 조인 조건 검사: 지정된 키 값이 같은지 확인
-                        // =============================================================
-                        int_t outer_key = getJoinKeyValue(outer_rec, outer_table_type);
-                        int_t inner_key = getJoinKeyValue(inner_rec, inner_table_type);
-
-                        // 조인 조건: outer_key == inner_key
-                        if (outer_key == inner_key) {
-                            // 조인 결과 레코드 생성 (두 레코드 병합)
-                            Record result_rec = mergeRecords(outer_rec, inner_rec);
-
-                            // ---------------------------------------------
-                            // 출력 블록에 쓰기 (버퍼링)
-                            // ---------------------------------------------
-                            if (!output_writer.writeRecord(result_rec)) {
-                                // 블록이 가득 차면 디스크에 플러시
-                                writer.writeBlock(&output_block);
-                                output_block.clear();
-
-                                // 새 블록에 다시 쓰기
-                                if (!output_writer.writeRecord(result_rec)) {
-                                    throw std::runtime_error("Result record too large for block");
-                                }
-                            }
-
-                            stats.output_records++;
-                        }
-                    } catch (const std::exception& e) {
-                        std::cerr << "Error during join: " << e.what() << std::endl;
+            for (size_t k = 0; k < selection.size(); ++k) {
+                const RecordView& outer_rec = outer_records[selection.outer_idx[k]];
+                const RecordView& inner_rec = inner_records[selection.inner_idx[k]];
+
+                // 두 레코드를 출력 블록에 직접 병합 (버퍼링)
+                if (!output_writer.writeJoined(&output_schema, outer_rec, inner_rec)) {
+                    // 블록이 가득 차면 디스크에 플러시 (write-behind면 빈 블록과 교환)
+                    writer.flushBlock(&output_block);
+
+                    // 새 블록에 다시 쓰기
+                    if (!output_writer.writeJoined(&output_schema, outer_rec, inner_rec)) {
+                        throw std::runtime_error("Result record too large for block");
                     }
                 }
+
+                stats.output_records++;
+            }
+
+        };
+
+        if (inner_pool) {
+            // 버퍼 풀: 앞선 청크에서 남아 있는 페이지는 디스크를 읽지 않음
+            // (프레임은 다음 청크를 위해 비우지 않고 pin만 해제)
+            size_t inner_page_count = inner_reader.getBlockCount();
+            for (size_t page = 0; page < inner_page_count; ++page) {
+                if (filter.skip(page)) {
+                    stats.blocks_skipped++;
+                    continue;
+                }
+                Block* frame = inner_pool->pin(inner_reader, 0, page);
+                if (!frame) break;
+                processInner(frame);
+                inner_pool->unpin(0, page);
             }
+        } else {
+            // Inner 테이블의 모든 블록 순회
+            while (inner_reader.readBlock(inner_block)) {
+                processInner(inner_block);
 
-            // Inner 블록 정리 (다음 블록 준비)
-            inner_block->clear();
+                // Inner 블록 정리 (다음 블록 준비)
+                inner_block->clear();
+            }
         }
 
-        std::cout << "Scanned " << inner_blocks_scanned << " inner blocks" << std::endl;
+        std::cout << "Scanned " << inner_blocks_scanned << " inner blocks";
+        if (filter.zones) {
+            std::cout << " (" << stats.blocks_skipped - skipped_before
+                      << " skipped by zone map)";
+        }
+        std::cout << std::endl;
     }
 
     // =========================================================================
@@ -331,3 +573,227 @@ void BlockNestedLoopsJoin::joinTables(
 
     std::cout << "\nJoin completed!" << std::endl;
 }
+
+
+// ============================================================================
+// 병렬 조인 함수: Inner 테이블을 블록 구간으로 나눠 스레드별 스캔
+// ============================================================================
+void BlockNestedLoopsJoin::joinTablesParallel(
+    BlockSource& outer_reader,
+    BlockSink& writer,
+    BufferManager& buffer_mgr) {
+
+    // =========================================================================
+    // 버퍼 할당 전략
+    // =========================================================================
+    //   - 스레드별 inner 버퍼: T 개 (버퍼 풀의 마지막 T개)
+    //   - Outer 청크: B-T 개
+    //   (inner 버퍼 풀이 있으면 스레드별 풀 프레임이 inner 버퍼를 대신하므로
+    //    buffer_mgr는 모두 outer용)
+    // 출력 블록은 순차 버전과 같이 버퍼 예산과 별도로 스레드마다 1개씩 관리
+    // =========================================================================
+    size_t thread_count = std::min(num_threads, buffer_size - 1);
+    size_t outer_buffer_count = inner_pool_frames > 0 ? buffer_mgr.getBufferCount()
+                                                      : buffer_size - thread_count;
+
+    // 스레드별 inner 리더 (각자 파일 위치를 가지므로 공유하지 않음)
+    thread_stats.assign(thread_count, Statistics());
+    // 미리 읽기 리더는 구간 끝에서 멈추도록 구간을 직접 지정하므로 따로 보관
+    std::vector<std::unique_ptr<BlockSource>> inner_readers;
+    std::vector<PrefetchReader*> inner_prefetchers;
+    for (size_t t = 0; t < thread_count; ++t) {
+        if (inner_scan == ScanMethod::READ && prefetch_depth > 0 && inner_pool_frames == 0 &&
+            !isExternalTable(inner_table_file)) {
+            PrefetchReader* prefetcher = new PrefetchReader(inner_table_file, block_size,
+                                                            prefetch_depth, &thread_stats[t]);
+            inner_readers.emplace_back(prefetcher);
+            inner_prefetchers.push_back(prefetcher);
+        } else {
+            inner_readers.push_back(openScan(inner_table_file, inner_scan, &thread_stats[t],
+                                             inner_pool_frames == 0));
+        }
+    }
+    size_t inner_block_count = inner_readers[0]->getBlockCount();
+
+    // 스레드별 inner 버퍼 풀 (스레드가 맡은 inner 구간이 겹치지 않으므로 프레임을 나눠 가짐)
+    std::vector<std::unique_ptr<BufferPool>> inner_pools;
+    if (inner_pool_frames > 0) {
+        size_t frames = std::max<size_t>(1, inner_pool_frames / thread_count);
+        for (size_t t = 0; t < thread_count; ++t) {
+            inner_pools.emplace_back(
+                new BufferPool(frames, block_size, inner_pool_policy, &thread_stats[t]));
+        }
+    }
+
+    std::cout << "Parallel BNLJ: " << thread_count << " threads, "
+              << outer_buffer_count << " outer blocks per chunk" << std::endl;
+
+    // 스레드별 출력 블록 (청크 간 유지, 가득 찬 블록만 공유 라이터에 기록)
+    std::vector<Block> output_blocks;
+    for (size_t t = 0; t < thread_count; ++t) {
+        output_blocks.emplace_back(block_size);
+    }
+    std::mutex writer_mutex;
+
+    std::vector<RecordView> outer_records;
+    std::vector<int_t> outer_keys;
+    ChunkHashIndex chunk_index;
+    size_t skipped_before = 0;   // 이전 청크까지 건너뛴 inner 페이지 수 (스레드 합)
+
+    // ========== 외부 루프: Outer 테이블을 (B-T)개 블록씩 처리 ==========
+    while (true) {
+        // =====================================================================
+        // 단계 1: Outer 테이블 블록들을 버퍼에 로드 (메인 스레드)
+        // =====================================================================
+        outer_records.clear();
+        outer_keys.clear();
+        size_t loaded_blocks = 0;
+
+        for (size_t i = 0; i < outer_buffer_count; ++i) {
+            Block* outer_block = buffer_mgr.getBuffer(i);
+            outer_block->clear();
+
+            if (!outer_reader.readBlock(outer_block)) {
+                break;
+            }
+            loaded_blocks++;
+            extractKeys(outer_block, outer_schema, outer_key_col, outer_records, outer_keys);
+        }
+
+        if (loaded_blocks == 0) {
+            break;
+        }
+
+        std::cout << "Loaded " << loaded_blocks << " outer blocks ("
+                  << outer_records.size() << " records)" << std::endl;
+
+        if (match_mode == ChunkMatchMode::HASH) {
+            chunk_index.build(outer_keys.data(), outer_keys.size());
+            if (chunk_index.getMemoryUsage() > chunk_index_memory) {
+                chunk_index_memory = chunk_index.getMemoryUsage();
+            }
+        }
+
+        // 존 맵이 있으면 청크 키 범위와 겹치지 않는 inner 페이지는 건너뜀
+        PageFilter filter = chunkFilter(outer_keys);
+
+        // =====================================================================
+        // 단계 2: 스레드별로 inner 구간 [begin, end) 스캔
+        // =====================================================================
+        // outer_records / outer_keys / chunk_index / filter는 이 단계 동안 읽기 전용
+        runParallel(thread_count, [&](size_t t) {
+            Statistics& local = thread_stats[t];
+            Block* inner_block =
+                inner_pools.empty() ? buffer_mgr.getBuffer(outer_buffer_count + t) : nullptr;
+            Block& output_block = output_blocks[t];
+            RecordWriter output_writer(&output_block);
+
+            KeyMatcher matcher(match_kernel);
+            SelectionVector selection;
+            std::vector<RecordView> inner_records;
+            std::vector<int_t> inner_keys;
+
+            size_t begin = inner_block_count * t / thread_count;
+            size_t end = inner_block_count * (t + 1) / thread_count;
+
+            auto processBlock = [&](const Block* inner_page) {
+                inner_records.clear();
+                inner_keys.clear();
+                extractKeys(inner_page, inner_schema, inner_key_col, inner_records, inner_keys);
+
+                selection.clear();
+                if (match_mode == ChunkMatchMode::HASH) {
+                    chunk_index.probeBlock(inner_keys.data(), inner_keys.size(), selection);
+                } else {
+                    matcher.matchBlock(outer_keys.data(), outer_keys.size(),
+                                       inner_keys.data(), inner_keys.size(), selection);
+                }
+
+                for (size_t k = 0; k < selection.size(); ++k) {
+                    const RecordView& outer_rec = outer_records[selection.outer_idx[k]];
+                    const RecordView& inner_rec = inner_records[selection.inner_idx[k]];
+
+                    if (!output_writer.writeJoined(&output_schema, outer_rec, inner_rec)) {
+                        {
+                            std::lock_guard<std::mutex> lock(writer_mutex);
+                            writer.flushBlock(&output_block);
+                        }
+
+                        if (!output_writer.writeJoined(&output_schema, outer_rec, inner_rec)) {
+                            throw std::runtime_error("Result record too large for block");
+                        }
+                    }
+
+                    local.output_records++;
+                }
+            };
+
+            // 구간 첫 페이지와 건너뛴 페이지 다음만 위치 지정, 이후는 순차 읽기
+            BlockSource& inner_reader = *inner_readers[t];
+            if (!inner_prefetchers.empty()) {
+                // 프리페처는 걸러진 페이지를 읽지 않고 건너뛴 수를 local에 기록
+                inner_prefetchers[t]->setPageFilter(filter);
+                inner_prefetchers[t]->restart(begin, end);
+                while (inner_reader.readBlock(inner_block)) {
+                    processBlock(inner_block);
+                    inner_block->clear();
+                }
+                return;
+            }
+
+            if (!inner_pools.empty()) {
+                // 스레드 몫의 버퍼 풀: 앞선 청크에서 남아 있는 페이지는 다시 읽지 않음
+                BufferPool& pool = *inner_pools[t];
+                for (size_t page = begin; page < end; ++page) {
+                    if (filter.skip(page)) {
+                        local.blocks_skipped++;
+                        continue;
+                    }
+                    Block* frame = pool.pin(inner_reader, 0, page);
+                    if (!frame) break;
+                    processBlock(frame);
+                    pool.unpin(0, page);
+                }
+                return;
+            }
+
+            bool contiguous = false;
+            for (size_t page = begin; page < end; ++page) {
+                if (filter.skip(page)) {
+                    local.blocks_skipped++;
+                    contiguous = false;
+                    continue;
+                }
+                bool ok = contiguous ? inner_reader.readBlock(inner_block)
+                                     : inner_reader.readBlockAt(page, inner_block);
+                if (!ok) break;
+                contiguous = true;
+                processBlock(inner_block);
+                inner_block->clear();
+            }
+        });
+
+        size_t skipped = 0;
+        for (const Statistics& ts : thread_stats) {
+            skipped += ts.blocks_skipped;
+        }
+        std::cout << "Scanned " << inner_block_count - (skipped - skipped_before)
+                  << " inner blocks";
+        if (filter.zones) {
+            std::cout << " (" << skipped - skipped_before << " skipped by zone map)";
+        }
+        std::cout << std::endl;
+        skipped_before = skipped;
+    }
+
+    // =========================================================================
+    // 단계 3: 스레드별 마지막 출력 블록 플러시
+    // =========================================================================
+    for (Block& output_block : output_blocks) {
+        if (!output_block.isEmpty()) {
+            writer.writeBlock(&output_block);
+        }
+    }
+
+    std::cout << "\nJoin completed!" << std::endl;
+}
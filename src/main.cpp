@@ -1,15 +1,45 @@
 #include "common.h"
 #include "block.h"
+#include "block_pool.h"
 #include "record.h"
 #include "table.h"
 #include "buffer.h"
 #include "join.h"
 #include "optimized_join.h"
+#include "external_sort.h"
+#include "benchmark.h"
+#include "external_table_reader.h"
+#include "file_manager.h"
+#include "table_metadata.h"
+#include "io_backend.h"
+#include "parallel.h"
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
 #include <sstream>
 #include <vector>
+#include <stdexcept>
+
+// "64M", "512K", "1G", "1048576" 형식의 바이트 크기 해석
+static size_t parseByteSize(const std::string& text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (end == text.c_str()) {
+        throw std::runtime_error("Invalid size: " + text);
+    }
+
+    std::string suffix(end);
+    if (suffix == "K" || suffix == "k" || suffix == "KB") {
+        value <<= 10;
+    } else if (suffix == "M" || suffix == "m" || suffix == "MB") {
+        value <<= 20;
+    } else if (suffix == "G" || suffix == "g" || suffix == "GB") {
+        value <<= 30;
+    } else if (!suffix.empty()) {
+        throw std::runtime_error("Invalid size suffix: " + text);
+    }
+    return static_cast<size_t>(value);
+}
 
 void printUsage(const char* program_name) {
     std::cout << "Usage: " << program_name << " [OPTION]...\n\n";
@@ -19,24 +49,88 @@ void printUsage(const char* program_name) {
     std::cout << "      --output-file FILE   Output block file path (.dat)\n";
     std::cout << "      --table-type TYPE    Table type: PART, PARTSUPP, SUPPLIER,\n";
     std::cout << "                           CUSTOMER, ORDERS, LINEITEM, NATION, REGION\n";
-    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n";
+    std::cout << "      --threads NUM        Parsing threads (default: 1, 0 = hardware threads)\n";
+    std::cout << "      --unordered          Write records in parse completion order instead of\n";
+    std::cout << "                           input order (output is not byte-identical)\n\n";
     std::cout << "  --join               Perform Block Nested Loops Join (2 tables)\n";
-    std::cout << "      --outer-table FILE   Outer table file (block format)\n";
-    std::cout << "      --inner-table FILE   Inner table file (block format)\n";
-    std::cout << "      --outer-type TYPE    Outer table type (any TPC-H table)\n";
-    std::cout << "      --inner-type TYPE    Inner table type (any TPC-H table)\n";
+    std::cout << "      --outer-table FILE   Outer table file (block format, or .tbl)\n";
+    std::cout << "      --inner-table FILE   Inner table file (block format, or .tbl)\n";
+    std::cout << "      --outer-type TYPE    Outer table type (any TPC-H table; optional when the\n";
+    std::cout << "                           table has a .meta file from --convert)\n";
+    std::cout << "      --inner-type TYPE    Inner table type (same as --outer-type)\n";
     std::cout << "      --join-key KEY       Join key: partkey, suppkey, custkey,\n";
     std::cout << "                           orderkey, nationkey, regionkey\n";
     std::cout << "      --output FILE        Output file path\n";
     std::cout << "      --buffer-size NUM    Number of buffer blocks (default: 10)\n";
-    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n";
+    std::cout << "      --match MODE         Chunk match mode: loop (default), hash\n";
+    std::cout << "                           hash builds a hash index over each outer chunk\n";
+    std::cout << "      --simd KERNEL        Key match kernel for loop mode: auto, avx2,\n";
+    std::cout << "                           sse2, scalar (default: auto, detected from CPU)\n";
+    std::cout << "      --threads NUM        Inner scan threads, each using one of the\n";
+    std::cout << "                           buffer blocks (default: 1, 0 = hardware threads)\n";
+    std::cout << "      --prefetch NUM       Blocks read ahead per input by a background\n";
+    std::cout << "                           I/O thread (default: 0 = synchronous reads)\n";
+    std::cout << "      --no-zone-maps       Scan every inner page; by default pages whose key\n";
+    std::cout << "                           range (.dat.zones from --convert) misses the outer\n";
+    std::cout << "                           chunk's key range are skipped\n";
+    std::cout << "      --inner-pool NUM     Frames of the buffer budget caching inner pages\n";
+    std::cout << "                           across outer chunks, leaving NUM fewer outer\n";
+    std::cout << "                           blocks (default: 0 = off; no inner prefetch)\n";
+    std::cout << "      --replacement POLICY Inner pool replacement: mru (default), lru,\n";
+    std::cout << "                           lru-k, clock\n\n";
     std::cout << "  --hash-join          Perform Hash Join (2 tables)\n";
-    std::cout << "      --build-table FILE   Build table file (smaller table, block format)\n";
-    std::cout << "      --probe-table FILE   Probe table file (larger table, block format)\n";
+    std::cout << "      --build-table FILE   Build table file (smaller table, block format or .tbl)\n";
+    std::cout << "      --probe-table FILE   Probe table file (larger table, block format or .tbl)\n";
+    std::cout << "      --build-type TYPE    Build table type (optional with a .meta file)\n";
+    std::cout << "      --probe-type TYPE    Probe table type (optional with a .meta file)\n";
+    std::cout << "      --join-key KEY       Join key (see --join for options)\n";
+    std::cout << "      --output FILE        Output file path\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n";
+    std::cout << "      --hash-mode MODE     memory (default), grace, hybrid, or radix\n";
+    std::cout << "                           grace partitions both inputs to disk first;\n";
+    std::cout << "                           hybrid keeps what fits in memory, spills the rest;\n";
+    std::cout << "                           radix partitions in memory to cache-sized pieces\n";
+    std::cout << "      --memory-limit SIZE  Hash table memory budget for grace/hybrid,\n";
+    std::cout << "                           e.g. 512K, 64M, 1G (default: 64M)\n";
+    std::cout << "      --radix-bits NUM     Radix mode fanout as 2^NUM partitions\n";
+    std::cout << "                           (default: chosen from the detected L2 cache size)\n";
+    std::cout << "      --cache-size SIZE    Radix mode partition target instead of the\n";
+    std::cout << "                           detected L2 cache size, e.g. 256K, 1M\n";
+    std::cout << "      --threads NUM        Worker threads for memory mode (default: 1,\n";
+    std::cout << "                           0 = number of hardware threads)\n";
+    std::cout << "      --prefetch NUM       Blocks read ahead per sequential scan by a\n";
+    std::cout << "                           background I/O thread (default: 0 = off)\n\n";
+    std::cout << "  --sort               External merge sort of one table by a column\n";
+    std::cout << "      --table FILE         Table file (block format, or .tbl)\n";
+    std::cout << "      --table-type TYPE    Table type (optional with a .meta file)\n";
+    std::cout << "      --key COLUMN         Sort column, e.g. partkey, supplycost, orderdate\n";
+    std::cout << "                           (ascending; strings compare bytewise)\n";
+    std::cout << "      --output FILE        Output file path\n";
+    std::cout << "      --buffer-size NUM    Memory budget in blocks, at least 3 (default: 10)\n";
+    std::cout << "                           runs come from replacement selection over\n";
+    std::cout << "                           NUM - 2 blocks and are merged NUM - 1 at a time\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n\n";
+    std::cout << "  --bench-hash-table   Benchmark hash join hash tables (flat vs unordered_map)\n";
+    std::cout << "      --build-table FILE   Build table file (block format)\n";
+    std::cout << "      --probe-table FILE   Probe table file (block format)\n";
     std::cout << "      --build-type TYPE    Build table type (any TPC-H table)\n";
     std::cout << "      --probe-type TYPE    Probe table type (any TPC-H table)\n";
     std::cout << "      --join-key KEY       Join key (see --join for options)\n";
-    std::cout << "      --output FILE        Output file path\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n\n";
+    std::cout << "  --info               Print table file information (from its .meta file when\n";
+    std::cout << "                       present, otherwise by scanning)\n";
+    std::cout << "      --table FILE         Table file (block format)\n\n";
+    std::cout << "  --bench-io           Benchmark block I/O backends on a cold-cache table scan\n";
+    std::cout << "      --table FILE         Table file to scan (block format)\n";
+    std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n";
+    std::cout << "      --io-depth NUM       io_uring requests in flight (default: 32)\n\n";
+    std::cout << "  --bench-ingest       Benchmark TBL parsing (fromCSV vs SIMD tokenizer)\n";
+    std::cout << "      --input-file FILE    Input TBL file path (pipe-delimited)\n";
+    std::cout << "      --table-type TYPE    Table type (see --convert)\n\n";
+    std::cout << "  --bench-blocks       Benchmark block allocation/reset (per-block malloc +\n";
+    std::cout << "                       memset vs recycled pool buffers)\n";
     std::cout << "      --block-size SIZE    Block size in bytes (default: 4096)\n\n";
     std::cout << "  --compare-all        Compare BNLJ and Hash Join performance\n";
     std::cout << "      --outer-table FILE   First table file (block format)\n";
@@ -45,6 +139,29 @@ void printUsage(const char* program_name) {
     std::cout << "      --inner-type TYPE    Second table type (any TPC-H table)\n";
     std::cout << "      --join-key KEY       Join key (see --join for options)\n";
     std::cout << "      --output-dir DIR     Output directory for result files\n\n";
+    std::cout << "--convert also writes FILE.meta next to the block file (table type, block size,\n";
+    std::cout << "counts, column min/max). Later runs take omitted table types and --block-size\n";
+    std::cout << "from it and reject a different --block-size.\n\n";
+    std::cout << "I/O options (all modes):\n";
+    std::cout << "  --io-backend NAME    Block I/O: stream (default), pread, uring\n";
+    std::cout << "                       uring falls back to pread if io_uring is unavailable\n";
+    std::cout << "  --direct-io          Open table files with O_DIRECT (pread/uring only)\n";
+    std::cout << "  --io-depth NUM       io_uring requests in flight per reader/writer (default: 32)\n";
+    std::cout << "  --scan METHOD        Join input scans: read (default) or mmap (zero-copy\n";
+    std::cout << "                       views into the mapped file)\n";
+    std::cout << "  --outer-scan METHOD  BNLJ outer scan only (overrides --scan)\n";
+    std::cout << "  --inner-scan METHOD  BNLJ inner scan only (overrides --scan)\n";
+    std::cout << "  --mmap-advice HINT   madvise for mmap scans: sequential (default),\n";
+    std::cout << "                       willneed, normal\n";
+    std::cout << "  --mmap-populate      Prefault mmap scans with MAP_POPULATE\n";
+    std::cout << "  --write-behind NUM   Join output pool blocks; a background thread writes\n";
+    std::cout << "                       full blocks in batches with pwritev (default: 0 = off)\n";
+    std::cout << "  --huge-pages         Back block buffers with huge pages (MAP_HUGETLB, else\n";
+    std::cout << "                       transparent huge pages)\n";
+    std::cout << "  --parse-threads NUM  Join inputs ending in .tbl are parsed on the fly into\n";
+    std::cout << "                       blocks; threads parsing ahead per scan (default: 0 =\n";
+    std::cout << "                       hardware threads). Each such scan buffers up to\n";
+    std::cout << "                       (2 x NUM + 1) x 4 MB, counted in --join/--sort memory\n\n";
     std::cout << "Examples:\n";
     std::cout << "  # Convert TBL files to block format\n";
     std::cout << "  " << program_name << " --convert --input-file data/part.tbl \\\n";
@@ -71,6 +188,20 @@ void printUsage(const char* program_name) {
     std::cout << "      --probe-table data/lineitem.dat --build-type ORDERS \\\n";
     std::cout << "      --probe-type LINEITEM --join-key orderkey \\\n";
     std::cout << "      --output output/orders_lineitem.dat\n\n";
+    std::cout << "  # Grace Hash Join with a 16 MB memory budget\n";
+    std::cout << "  " << program_name << " --hash-join --build-table data/orders.dat \\\n";
+    std::cout << "      --probe-table data/lineitem.dat --build-type ORDERS \\\n";
+    std::cout << "      --probe-type LINEITEM --join-key orderkey \\\n";
+    std::cout << "      --output output/orders_lineitem.dat \\\n";
+    std::cout << "      --hash-mode grace --memory-limit 16M\n\n";
+    std::cout << "  # Hash Join directly over TBL files (no --convert step)\n";
+    std::cout << "  " << program_name << " --hash-join --build-table data/orders.tbl \\\n";
+    std::cout << "      --probe-table data/lineitem.tbl --build-type ORDERS \\\n";
+    std::cout << "      --probe-type LINEITEM --join-key orderkey \\\n";
+    std::cout << "      --output output/orders_lineitem.dat\n\n";
+    std::cout << "  # External sort: LINEITEM by shipdate with 64 buffer blocks\n";
+    std::cout << "  " << program_name << " --sort --table data/lineitem.dat \\\n";
+    std::cout << "      --key shipdate --output output/lineitem_sorted.dat --buffer-size 64\n\n";
     std::cout << "  # Compare BNLJ vs Hash Join performance\n";
     std::cout << "  " << program_name << " --compare-all --outer-table data/part.dat \\\n";
     std::cout << "      --inner-table data/partsupp.dat --outer-type PART \\\n";
@@ -91,8 +222,28 @@ int main(int argc, char* argv[]) {
         std::string build_table, probe_table, build_type, probe_type;
         std::string output_dir;
         std::string join_key;
+        std::string sort_key;
         size_t buffer_size = 10;
         size_t block_size = DEFAULT_BLOCK_SIZE;
+        bool block_size_set = false;
+        std::string simd_kernel = "auto";
+        std::string match_mode = "loop";
+        std::string hash_mode = "memory";
+        size_t memory_limit = 64 * 1024 * 1024;
+        size_t radix_bits = 0;
+        size_t cache_size = 0;
+        size_t threads = 1;
+        size_t prefetch = 0;
+        size_t write_behind = 0;
+        bool preserve_order = true;
+        bool zone_maps = true;
+        size_t inner_pool = 0;
+        std::string replacement = "mru";
+        std::string bench_table;
+        IoOptions io_options;
+        std::string scan = "read";
+        std::string outer_scan, inner_scan;
+        MapOptions map_options;
 
         // 인자 파싱
         for (int i = 1; i < argc; ++i) {
@@ -106,6 +257,12 @@ int main(int argc, char* argv[]) {
                 mode = "hash-join";
             } else if (arg == "--compare-all") {
                 mode = "compare-all";
+            } else if (arg == "--bench-hash-table") {
+                mode = "bench-hash-table";
+            } else if (arg == "--sort") {
+                mode = "sort";
+            } else if (arg == "--key" && i + 1 < argc) {
+                sort_key = argv[++i];
             } else if (arg == "--input-file" && i + 1 < argc) {
                 input_file = argv[++i];
             } else if (arg == "--output-file" && i + 1 < argc) {
@@ -138,6 +295,63 @@ int main(int argc, char* argv[]) {
                 buffer_size = std::atoi(argv[++i]);
             } else if (arg == "--block-size" && i + 1 < argc) {
                 block_size = std::atoi(argv[++i]);
+                block_size_set = true;
+            } else if (arg == "--simd" && i + 1 < argc) {
+                simd_kernel = argv[++i];
+            } else if (arg == "--match" && i + 1 < argc) {
+                match_mode = argv[++i];
+            } else if (arg == "--hash-mode" && i + 1 < argc) {
+                hash_mode = argv[++i];
+            } else if (arg == "--memory-limit" && i + 1 < argc) {
+                memory_limit = parseByteSize(argv[++i]);
+            } else if (arg == "--radix-bits" && i + 1 < argc) {
+                radix_bits = std::atoi(argv[++i]);
+            } else if (arg == "--cache-size" && i + 1 < argc) {
+                cache_size = parseByteSize(argv[++i]);
+            } else if (arg == "--bench-blocks") {
+                mode = "bench-blocks";
+            } else if (arg == "--huge-pages") {
+                BlockPool::setHugePages(true);
+            } else if (arg == "--bench-ingest") {
+                mode = "bench-ingest";
+            } else if (arg == "--info") {
+                mode = "info";
+            } else if (arg == "--bench-io") {
+                mode = "bench-io";
+            } else if (arg == "--table" && i + 1 < argc) {
+                bench_table = argv[++i];
+            } else if (arg == "--io-backend" && i + 1 < argc) {
+                io_options.backend = parseIoBackend(argv[++i]);
+            } else if (arg == "--direct-io") {
+                io_options.direct = true;
+            } else if (arg == "--io-depth" && i + 1 < argc) {
+                io_options.queue_depth = std::atoi(argv[++i]);
+            } else if (arg == "--scan" && i + 1 < argc) {
+                scan = argv[++i];
+            } else if (arg == "--outer-scan" && i + 1 < argc) {
+                outer_scan = argv[++i];
+            } else if (arg == "--inner-scan" && i + 1 < argc) {
+                inner_scan = argv[++i];
+            } else if (arg == "--mmap-advice" && i + 1 < argc) {
+                map_options.advice = parseMapAdvice(argv[++i]);
+            } else if (arg == "--mmap-populate") {
+                map_options.populate = true;
+            } else if (arg == "--prefetch" && i + 1 < argc) {
+                prefetch = std::atoi(argv[++i]);
+            } else if (arg == "--unordered") {
+                preserve_order = false;
+            } else if (arg == "--inner-pool" && i + 1 < argc) {
+                inner_pool = std::atoi(argv[++i]);
+            } else if (arg == "--replacement" && i + 1 < argc) {
+                replacement = argv[++i];
+            } else if (arg == "--no-zone-maps") {
+                zone_maps = false;
+            } else if (arg == "--write-behind" && i + 1 < argc) {
+                write_behind = std::atoi(argv[++i]);
+            } else if (arg == "--parse-threads" && i + 1 < argc) {
+                setExternalParseThreads(std::atoi(argv[++i]));
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = resolveThreadCount(std::atoi(argv[++i]));
             } else if (arg == "--help" || arg == "-h") {
                 printUsage(argv[0]);
                 return 0;
@@ -148,6 +362,37 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // 입력 블록 파일의 메타데이터로 생략한 테이블 타입과 블록 크기를 채움
+        if (mode != "convert") {
+            auto applyMetadata = [&](const std::string& file, std::string* type) {
+                TableMetadata meta;
+                if (file.empty() || !TableMetadata::load(file, meta)) return;
+                if (type && type->empty()) {
+                    *type = meta.table_type;
+                } else if (type && *type != meta.table_type) {
+                    throw std::runtime_error("Table type " + *type + " does not match " +
+                                             meta.table_type + " recorded for " + file);
+                }
+                if (!block_size_set) {
+                    block_size = meta.block_size;
+                    block_size_set = true;
+                }
+            };
+            applyMetadata(outer_table, &outer_type);
+            applyMetadata(inner_table, &inner_type);
+            applyMetadata(build_table, &build_type);
+            applyMetadata(probe_table, &probe_type);
+            applyMetadata(bench_table, mode == "sort" ? &table_type : nullptr);
+        }
+
+        // 이후 생성되는 모든 테이블 리더/라이터의 I/O 방식
+        io_options = resolveIoOptions(io_options, block_size);
+        setDefaultIoOptions(io_options);
+        if (io_options.backend != IoBackend::STREAM) {
+            std::cout << "I/O Backend: " << ioBackendName(io_options.backend)
+                      << (io_options.direct ? " (O_DIRECT)" : "") << std::endl;
+        }
+
         // TBL 변환 모드
         if (mode == "convert") {
             if (input_file.empty() || output_file_convert.empty() || table_type.empty()) {
@@ -163,7 +408,8 @@ int main(int argc, char* argv[]) {
             std::cout << "Table Type: " << table_type << "\n";
             std::cout << "Block Size: " << block_size << " bytes\n\n";
 
-            convertTBLToBlocks(input_file, output_file_convert, table_type, block_size);
+            convertTBLToBlocks(input_file, output_file_convert, table_type, block_size,
+                               threads, preserve_order);
 
             std::cout << "Conversion completed successfully!\n";
         }
@@ -192,6 +438,21 @@ int main(int argc, char* argv[]) {
             BlockNestedLoopsJoin join(outer_table, inner_table, output_file,
                                      outer_type, inner_type, join_key,
                                      buffer_size, block_size);
+            join.setMatchKernel(KeyMatcher::parseKernel(simd_kernel));
+            join.setThreads(threads);
+            join.setPrefetchDepth(prefetch);
+            join.setWriteBehind(write_behind);
+            join.setScanMethods(parseScanMethod(outer_scan.empty() ? scan : outer_scan),
+                                parseScanMethod(inner_scan.empty() ? scan : inner_scan));
+            join.setMapOptions(map_options);
+            join.setZoneMaps(zone_maps);
+            join.setInnerPool(inner_pool, parseReplacementPolicy(replacement));
+            if (match_mode == "hash") {
+                join.setMatchMode(ChunkMatchMode::HASH);
+            } else if (match_mode != "loop") {
+                std::cerr << "Error: Unknown match mode: " << match_mode << "\n";
+                return 1;
+            }
             join.execute();
 
             std::cout << "\nJoin completed successfully!\n";
@@ -217,10 +478,55 @@ int main(int argc, char* argv[]) {
 
             HashJoin join(build_table, probe_table, output_file,
                          build_type, probe_type, join_key, block_size);
+            join.setThreads(threads);
+            join.setPrefetchDepth(prefetch);
+            join.setWriteBehind(write_behind);
+            join.setScanMethod(parseScanMethod(scan));
+            join.setMapOptions(map_options);
+            if (hash_mode == "grace") {
+                join.setMode(HashJoinMode::GRACE);
+                join.setMemoryLimit(memory_limit);
+            } else if (hash_mode == "hybrid") {
+                join.setMode(HashJoinMode::HYBRID);
+                join.setMemoryLimit(memory_limit);
+            } else if (hash_mode == "radix") {
+                join.setMode(HashJoinMode::RADIX);
+                join.setRadixBits(radix_bits);
+                if (cache_size > 0) join.setCacheSize(cache_size);
+            } else if (hash_mode != "memory") {
+                std::cerr << "Error: Unknown hash join mode: " << hash_mode << "\n";
+                return 1;
+            }
             join.execute();
 
             std::cout << "\nHash Join completed successfully!\n";
         }
+        // 외부 정렬 모드
+        else if (mode == "sort") {
+            if (bench_table.empty() || table_type.empty() ||
+                sort_key.empty() || output_file.empty()) {
+                std::cerr << "Error: Missing required arguments for sort\n";
+                std::cerr << "Required: --table, --table-type, --key, --output\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            std::cout << "=== External Merge Sort ===" << std::endl;
+            std::cout << "Table: " << bench_table << " (" << table_type << ")" << std::endl;
+            std::cout << "Sort Key: " << sort_key << std::endl;
+            std::cout << "Output File: " << output_file << std::endl;
+            std::cout << "Buffer Size: " << buffer_size << " blocks" << std::endl;
+            std::cout << "Block Size: " << block_size << " bytes" << std::endl;
+            std::cout << "Total Memory: " << (buffer_size * block_size / 1024.0 / 1024.0)
+                      << " MB" << std::endl;
+            std::cout << "\nExecuting sort...\n" << std::endl;
+
+            ExternalSort sorter(bench_table, output_file, table_type, sort_key,
+                                buffer_size, block_size);
+            sorter.execute();
+
+            std::cout << "\nSort completed successfully!\n";
+        }
         // 성능 비교 모드
         else if (mode == "compare-all") {
             if (outer_table.empty() || inner_table.empty() ||
@@ -244,8 +550,61 @@ int main(int argc, char* argv[]) {
 
             std::cout << "\nPerformance comparison completed!\n";
         }
+        // 해시 테이블 벤치마크 모드
+        else if (mode == "bench-hash-table") {
+            if (build_table.empty() || probe_table.empty() ||
+                build_type.empty() || probe_type.empty() || join_key.empty()) {
+                std::cerr << "Error: Missing required arguments for hash table benchmark\n";
+                std::cerr << "Required: --build-table, --probe-table, --build-type, --probe-type, --join-key\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            Benchmark::hashTables(build_table, probe_table, build_type, probe_type,
+                                  join_key, block_size);
+        }
+        // 테이블 파일 정보
+        else if (mode == "info") {
+            if (bench_table.empty()) {
+                std::cerr << "Error: Missing required arguments for table info\n";
+                std::cerr << "Required: --table\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            FileManager file_manager(block_size, 1);
+            file_manager.printFileInfo(bench_table);
+        }
+        // 블록 I/O 백엔드 벤치마크 모드
+        else if (mode == "bench-io") {
+            if (bench_table.empty()) {
+                std::cerr << "Error: Missing required arguments for I/O benchmark\n";
+                std::cerr << "Required: --table\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            Benchmark::ioBackends(bench_table, block_size, io_options.queue_depth);
+        }
+        // 블록 할당 벤치마크 모드
+        else if (mode == "bench-blocks") {
+            Benchmark::blockPool(block_size);
+        }
+        // TBL 파싱 벤치마크 모드
+        else if (mode == "bench-ingest") {
+            if (input_file.empty() || table_type.empty()) {
+                std::cerr << "Error: Missing required arguments for ingest benchmark\n";
+                std::cerr << "Required: --input-file, --table-type\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+
+            Benchmark::ingest(input_file, table_type);
+        }
         else {
-            std::cerr << "Error: Please specify one of: --convert, --join, --hash-join, --compare-all\n";
+            std::cerr << "Error: Please specify one of: --convert, --join, --hash-join, --sort,\n";
+            std::cerr << "       --compare-all, --info, --bench-hash-table, --bench-io, --bench-ingest,\n";
+            std::cerr << "       --bench-blocks\n";
             printUsage(argv[0]);
             return 1;
         }
@@ -0,0 +1,128 @@
+#include "mapped_table_reader.h"
+#include "table_metadata.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ScanMethod parseScanMethod(const std::string& name) {
+    if (name == "read") return ScanMethod::READ;
+    if (name == "mmap") return ScanMethod::MMAP;
+    throw std::runtime_error("Unknown scan method: " + name);
+}
+
+MapAdvice parseMapAdvice(const std::string& name) {
+    if (name == "normal") return MapAdvice::NORMAL;
+    if (name == "sequential") return MapAdvice::SEQUENTIAL;
+    if (name == "willneed") return MapAdvice::WILLNEED;
+    throw std::runtime_error("Unknown mmap advice: " + name);
+}
+
+MappedTableReader::MappedTableReader(const std::string& fname, size_t blk_size,
+                                     Statistics* st, const MapOptions& options)
+    : filename(fname), fd(-1), mapping(nullptr), map_size(0),
+      block_size(blk_size), block_count(0), next_page(0), stats(st) {
+
+    TableMetadata::checkBlockSize(filename, block_size);
+
+    fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+
+    struct stat st_buf;
+    if (fstat(fd, &st_buf) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + filename);
+    }
+    map_size = static_cast<size_t>(st_buf.st_size);
+
+    // 파일 크기는 항상 페이지 크기의 배수여야 함
+    if (map_size % block_size != 0) {
+        ::close(fd);
+        throw std::runtime_error("File size of " + filename + " (" + std::to_string(map_size) +
+                                 " bytes) is not a multiple of block size " +
+                                 std::to_string(block_size));
+    }
+    block_count = map_size / block_size;
+
+    // 빈 파일은 매핑하지 않음 (mmap 길이 0은 오류)
+    if (map_size == 0) {
+        return;
+    }
+
+    int flags = MAP_PRIVATE | (options.populate ? MAP_POPULATE : 0);
+    void* addr = mmap(nullptr, map_size, PROT_READ, flags, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Failed to mmap " + filename + ": " + std::strerror(errno));
+    }
+    mapping = static_cast<const char*>(addr);
+
+    // 힌트 실패는 성능 문제일 뿐이므로 무시
+    if (options.advice == MapAdvice::SEQUENTIAL) {
+        madvise(addr, map_size, MADV_SEQUENTIAL);
+    } else if (options.advice == MapAdvice::WILLNEED) {
+        madvise(addr, map_size, MADV_WILLNEED);
+    }
+}
+
+MappedTableReader::~MappedTableReader() {
+    if (mapping) {
+        munmap(const_cast<char*>(mapping), map_size);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void MappedTableReader::attachPage(Block* block, size_t page_no) {
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while reading " + filename);
+    }
+
+    block->attach(mapping + page_no * block_size);
+    if (!block->isValid()) {
+        block->clear();
+        throw std::runtime_error("Corrupt page " + std::to_string(page_no) + " in " +
+                                 filename + " (wrong --block-size?)");
+    }
+
+    if (stats) {
+        stats->block_reads++;
+    }
+}
+
+bool MappedTableReader::readBlock(Block* block) {
+    size_t start = next_page;
+    while (next_page < block_count && filter.skip(next_page)) {
+        next_page++;
+    }
+    if (stats) {
+        stats->blocks_skipped += next_page - start;
+    }
+    if (next_page >= block_count) {
+        return false;
+    }
+
+    attachPage(block, next_page);
+    next_page++;
+    return true;
+}
+
+bool MappedTableReader::readBlockAt(size_t page_no, Block* block) {
+    if (page_no >= block_count) {
+        return false;
+    }
+
+    attachPage(block, page_no);
+    next_page = page_no + 1;
+    return true;
+}
+
+void MappedTableReader::reset() {
+    next_page = 0;
+}
@@ -1,12 +1,62 @@
 #include "optimized_join.h"
+#include "external_table_reader.h"
+#include "system_info.h"
+#include "table_metadata.h"
+#include "mapped_table_reader.h"
+#include "parallel.h"
+#include "prefetch_reader.h"
+#include "write_behind_writer.h"
+#include "temp_files.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
 
 // ============================================================================
 // Hash Join 구현 (일반화 버전)
 // ============================================================================
 
+// 메모리 해시 테이블 크기 ≈ 디스크상 Build 블록 크기 × 이 값
+// (arena에 레코드 바이트 + 레코드당 엔트리 16 bytes + 적재율 0.7 이하 슬롯 배열)
+static const double HASH_TABLE_OVERHEAD = 1.3;
+
+// Grace 모드 분할 한계
+static const size_t MAX_GRACE_FANOUT = 256;   // 한 번에 만들 최대 파티션 수
+static const size_t MAX_GRACE_DEPTH = 4;      // 최대 재분할 깊이
+static const size_t HYBRID_FANOUT_FACTOR = 4;  // Hybrid 모드 파티션 수 배율 (Grace 대비)
+
+// Radix 모드 분할 한계
+static const size_t RADIX_MAX_BITS_PER_PASS = 8;   // 패스당 최대 256개 파티션 (TLB 미스 방지)
+static const size_t RADIX_MAX_BITS = 16;           // 최대 2패스
+static const size_t RADIX_TUPLE_FOOTPRINT = 24;    // 파티션 내 Build 튜플당 바이트
+                                                   // (키 + 행 번호 + next + 버킷 헤드 2개)
+static const size_t DEFAULT_CACHE_SIZE = 256 * 1024;   // 캐시 크기를 알 수 없을 때
+
+// 병렬 실행
+static const size_t MORSEL_BLOCKS = 16;            // 스레드가 한 번에 가져가는 블록 수
+static const size_t PARTITIONS_PER_THREAD = 4;     // 병렬 구축 파티션 수 배율 (부하 분산)
+
+// 파티션 번호용 키 해시 (단계마다 시드를 바꿔 재분할 시 다르게 분배)
+static inline uint32_t partitionHash(int_t key, size_t level) {
+    uint32_t h = static_cast<uint32_t>(key) ^ (0x9e3779b9u * static_cast<uint32_t>(level + 1));
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// 임시 파티션 파일 리더/라이터의 I/O 설정 (io_uring 창을 SPILL_QUEUE_DEPTH 블록으로 제한)
+static IoOptions spillIoOptions() {
+    return limitQueueDepth(getDefaultIoOptions(), SPILL_QUEUE_DEPTH);
+}
+
 HashJoin::HashJoin(
     const std::string& build_file,
     const std::string& probe_file,
@@ -21,163 +71,869 @@ HashJoin::HashJoin(
       build_table_type(build_type),
       probe_table_type(probe_type),
       join_key(join_key_name),
-      block_size(blk_size) {
+      block_size(blk_size),
+      build_schema(&Schema::forTable(build_type)),
+      probe_schema(&Schema::forTable(probe_type)),
+      output_schema(Schema::concat(*build_schema, *probe_schema)),
+      build_key_col(build_schema->getKeyColumn(join_key_name)),
+      probe_key_col(probe_schema->getKeyColumn(join_key_name)),
+      mode(HashJoinMode::IN_MEMORY),
+      memory_limit(0),
+      peak_hash_memory(0),
+      build_table_blocks(0),
+      probe_table_blocks(0),
+      build_records(0),
+      probe_records(0),
+      partitions_created(0),
+      max_depth(0),
+      chunked_partitions(0),
+      max_fanout(0),
+      radix_bits(0),
+      cache_size(detectCacheSize(2)),
+      radix_passes(0),
+      radix_fanout(0),
+      partition_time(0.0),
+      join_time(0.0),
+      num_threads(1),
+      prefetch_depth(0),
+      scan_method(ScanMethod::READ),
+      write_behind_blocks(0),
+      output_write_calls(0),
+      output_stall_time(0.0) {
+    if (cache_size == 0) {
+        cache_size = DEFAULT_CACHE_SIZE;
+    }
+}
+
+void HashJoin::clearHashTable() {
+    hash_table.clear();
+}
+
+void HashJoin::insertBuildRecord(int_t key, const RecordView& record) {
+    // 블록은 재사용되므로 레코드 바이트를 해시 테이블 arena로 복사
+    hash_table.insert(key, record.getData(), record.getSize());
+    build_records++;
+}
+
+std::unique_ptr<BlockSource> HashJoin::openReader(const std::string& file,
+                                                  Statistics* read_stats) {
+    if (isExternalTable(file)) {
+        const std::string& type = (file == build_table_file) ? build_table_type : probe_table_type;
+        return std::unique_ptr<BlockSource>(
+            new ExternalTableReader(file, type, block_size, read_stats));
+    }
+    if (scan_method == ScanMethod::MMAP) {
+        return std::unique_ptr<BlockSource>(
+            new MappedTableReader(file, block_size, read_stats, map_options));
+    }
+    if (prefetch_depth > 0) {
+        return std::unique_ptr<BlockSource>(
+            new PrefetchReader(file, block_size, prefetch_depth, read_stats));
+    }
+    // 임시 파티션 파일은 깊이를 줄인 io_uring 창으로 읽음 (입력 테이블은 기본 설정)
+    if (file != build_table_file && file != probe_table_file) {
+        return std::unique_ptr<BlockSource>(
+            new TableReader(file, block_size, read_stats, spillIoOptions()));
+    }
+    return std::unique_ptr<BlockSource>(new TableReader(file, block_size, read_stats));
 }
 
-int_t HashJoin::getJoinKeyValue(const Record& rec, const std::string& table_type) {
-    if (table_type == "PART") {
-        PartRecord part = PartRecord::fromRecord(rec);
-        if (join_key == "partkey") {
-            return part.partkey;
+size_t HashJoin::buildHashTable(BlockSource& reader, size_t max_blocks,
+                                size_t expected_records, size_t expected_bytes) {
+    Block block(block_size);
+    size_t blocks_loaded = 0;
+
+    // 읽을 블록 수의 상한
+    size_t expected_blocks = reader.getBlockCount();
+    if (max_blocks != 0) {
+        expected_blocks = std::min(expected_blocks, max_blocks);
+    }
+
+    // Build 입력의 레코드를 읽어 해시 테이블 구축
+    while ((max_blocks == 0 || blocks_loaded < max_blocks) && reader.readBlock(&block)) {
+        RecordReader rec_reader(&block, build_schema);
+
+        // 첫 블록의 레코드 수로 전체 크기를 추정해 미리 할당 (구축 중 rehash/재할당 방지)
+        if (blocks_loaded == 0 && expected_records > 0) {
+            hash_table.reserve(expected_records, expected_bytes);
+        } else if (blocks_loaded == 0) {
+            hash_table.reserve(block.getRecordCount() * expected_blocks,
+                               block.getUsedSize() * expected_blocks);
         }
-    } else if (table_type == "PARTSUPP") {
-        PartSuppRecord partsupp = PartSuppRecord::fromRecord(rec);
-        if (join_key == "partkey") {
-            return partsupp.partkey;
-        } else if (join_key == "suppkey") {
-            return partsupp.suppkey;
+
+        while (rec_reader.hasNext()) {
+            RecordView record = rec_reader.readNext();
+
+            // 조인 키 값 추출
+            insertBuildRecord(record.getInt(build_key_col), record);
         }
-    } else if (table_type == "SUPPLIER") {
-        SupplierRecord supplier = SupplierRecord::fromRecord(rec);
-        if (join_key == "suppkey") {
-            return supplier.suppkey;
-        } else if (join_key == "nationkey") {
-            return supplier.nationkey;
+
+        block.clear();
+        blocks_loaded++;
+    }
+
+    peak_hash_memory = std::max(peak_hash_memory, hash_table.getMemoryUsage());
+    return blocks_loaded;
+}
+
+void HashJoin::emitJoined(const RecordView& build_record, const RecordView& probe_record,
+                          BlockSink& writer, Block& output_block) {
+    RecordWriter output_writer(&output_block);
+
+    // 출력 블록에 직접 병합 (Build 필드 뒤에 Probe 필드)
+    if (!output_writer.writeJoined(&output_schema, build_record, probe_record)) {
+        writer.flushBlock(&output_block);
+
+        if (!output_writer.writeJoined(&output_schema, build_record, probe_record)) {
+            throw std::runtime_error("Result record too large for block");
         }
-    } else if (table_type == "CUSTOMER") {
-        CustomerRecord customer = CustomerRecord::fromRecord(rec);
-        if (join_key == "custkey") {
-            return customer.custkey;
-        } else if (join_key == "nationkey") {
-            return customer.nationkey;
+    }
+
+    stats.output_records++;
+}
+
+void HashJoin::probeKey(int_t key, const RecordView& probe_record,
+                        BlockSink& writer, Block& output_block) {
+    for (uint32_t e = hash_table.find(key); e != FlatHashTable::NONE; e = hash_table.next(e)) {
+        RecordView build_record(build_schema, hash_table.payload(e), hash_table.payloadSize(e));
+        emitJoined(build_record, probe_record, writer, output_block);
+    }
+}
+
+void HashJoin::probeAndJoin(BlockSource& reader, BlockSink& writer, Block& output_block) {
+    Block input_block(block_size);
+
+    // Probe 입력을 스캔하며 해시 테이블에서 매칭
+    while (reader.readBlock(&input_block)) {
+        RecordReader rec_reader(&input_block, probe_schema);
+
+        while (rec_reader.hasNext()) {
+            RecordView probe_record = rec_reader.readNext();
+            probe_records++;
+
+            // 해시 테이블에서 매칭되는 모든 Build 레코드와 조인
+            probeKey(probe_record.getInt(probe_key_col), probe_record, writer, output_block);
         }
-    } else if (table_type == "ORDERS") {
-        OrdersRecord orders = OrdersRecord::fromRecord(rec);
-        if (join_key == "orderkey") {
-            return orders.orderkey;
-        } else if (join_key == "custkey") {
-            return orders.custkey;
+
+        input_block.clear();
+    }
+}
+
+// ============================================================================
+// 파티션 출력 (Grace / Hybrid 공용)
+// ============================================================================
+
+// 파티션마다 블록 하나를 버퍼링하고, 가득 차면 해당 임시 파일에 기록
+// 파일과 블록은 첫 레코드가 들어올 때 만들어지므로 빈 파티션은 메모리/파일을 쓰지 않음
+// io_uring이면 열린 파티션마다 라이터의 창 블록 (SPILL_QUEUE_DEPTH개)이 더 있음
+class PartitionOutput {
+private:
+    std::vector<std::string> files;
+    size_t block_size;
+    Statistics* stats;
+    std::vector<std::unique_ptr<TableWriter>> writers;
+    std::vector<std::unique_ptr<Block>> blocks;
+    IoOptions io;
+
+public:
+    std::vector<size_t> block_counts;    // 파티션별 기록한 블록 수
+    std::vector<size_t> record_counts;   // 파티션별 레코드 수
+
+    PartitionOutput(const std::vector<std::string>& part_files, size_t blk_size, Statistics* st)
+        : files(part_files), block_size(blk_size), stats(st),
+          writers(part_files.size()), blocks(part_files.size()), io(spillIoOptions()),
+          block_counts(part_files.size(), 0), record_counts(part_files.size(), 0) {}
+
+    void append(size_t p, const RecordView& record) {
+        if (!blocks[p]) {
+            writers[p].reset(new TableWriter(files[p], stats, io));
+            blocks[p].reset(new Block(block_size));
         }
-    } else if (table_type == "LINEITEM") {
-        LineItemRecord lineitem = LineItemRecord::fromRecord(rec);
-        if (join_key == "orderkey") {
-            return lineitem.orderkey;
-        } else if (join_key == "partkey") {
-            return lineitem.partkey;
-        } else if (join_key == "suppkey") {
-            return lineitem.suppkey;
+
+        // 레코드 바이트를 그대로 파티션 블록에 복사
+        if (!blocks[p]->append(record.getData(), record.getSize())) {
+            writers[p]->writeBlock(blocks[p].get());
+            blocks[p]->clear();
+            block_counts[p]++;
+
+            if (!blocks[p]->append(record.getData(), record.getSize())) {
+                throw std::runtime_error("Record too large for block");
+            }
         }
-    } else if (table_type == "NATION") {
-        NationRecord nation = NationRecord::fromRecord(rec);
-        if (join_key == "nationkey") {
-            return nation.nationkey;
-        } else if (join_key == "regionkey") {
-            return nation.regionkey;
+        record_counts[p]++;
+    }
+
+    // 남은 파티션 블록을 기록하고 파일을 닫음
+    void finish() {
+        for (size_t p = 0; p < blocks.size(); ++p) {
+            if (blocks[p] && !blocks[p]->isEmpty()) {
+                writers[p]->writeBlock(blocks[p].get());
+                block_counts[p]++;
+            }
+            blocks[p].reset();
+            if (writers[p]) {
+                writers[p]->close();
+            }
+            writers[p].reset();
         }
-    } else if (table_type == "REGION") {
-        RegionRecord region = RegionRecord::fromRecord(rec);
-        if (join_key == "regionkey") {
-            return region.regionkey;
+    }
+
+    // 현재 버퍼 블록을 들고 있는 파티션 수
+    size_t openCount() const {
+        size_t count = 0;
+        for (const auto& block : blocks) {
+            count += block ? 1 : 0;
         }
+        return count;
     }
 
-    throw std::runtime_error("Invalid join key '" + join_key + "' for table type '" + table_type + "'");
+    // 열린 파티션이 차지하는 블록 수 (버퍼 블록 + io_uring 창)
+    size_t bufferBlocks() const {
+        return openCount() * (1 + ioWindowBlocks(io));
+    }
+
+    size_t size() const { return files.size(); }
+    const std::string& file(size_t p) const { return files[p]; }
+};
+
+// ============================================================================
+// Grace Hash Join
+// ============================================================================
+
+bool HashJoin::fitsInMemory(size_t blocks) const {
+    return static_cast<double>(blocks) * block_size * HASH_TABLE_OVERHEAD <=
+           static_cast<double>(memory_limit);
 }
 
-void HashJoin::buildHashTable() {
-    std::cout << "Building hash table from " << build_table_file << "..." << std::endl;
+size_t HashJoin::maxPartitionFanout() const {
+    size_t per_partition = 1 + ioWindowBlocks(spillIoOptions());
+    return std::max<size_t>(2, (memory_limit / block_size - 1) / per_partition);
+}
 
-    TableReader reader(build_table_file, block_size, &stats);
-    Block block(block_size);
+size_t HashJoin::chooseFanout(size_t blocks) const {
+    // 파티션 하나가 예산에 들어가도록 필요한 최소 개수에 키 분포 편차 여유 25%
+    double needed = static_cast<double>(blocks) * block_size * HASH_TABLE_OVERHEAD /
+                    static_cast<double>(memory_limit);
+    size_t fanout = static_cast<size_t>(needed * 1.25) + 1;
 
-    size_t records_loaded = 0;
+    // 분할 중에는 입력 1블록 + 파티션마다 출력 1블록 (+ io_uring 창)이 예산 안에 있어야 함
+    size_t limit = std::min(MAX_GRACE_FANOUT, maxPartitionFanout());
+    return std::max<size_t>(2, std::min(fanout, limit));
+}
 
-    // Build 테이블의 모든 레코드를 읽어 해시 테이블 구축
-    while (reader.readBlock(&block)) {
-        RecordReader rec_reader(&block);
+std::vector<std::string> HashJoin::partitionFileNames(const std::string& side,
+                                                      const std::string& path,
+                                                      size_t fanout) const {
+    std::vector<std::string> names;
+    for (size_t p = 0; p < fanout; ++p) {
+        names.push_back(output_file + ".part." + side + "." + partitionId(path, p) + ".tmp");
+    }
+    return names;
+}
+
+std::string HashJoin::partitionId(const std::string& path, size_t p) {
+    return path.empty() ? std::to_string(p) : path + "_" + std::to_string(p);
+}
+
+void HashJoin::partitionFile(const std::string& input_file, Statistics* read_stats,
+                             const Schema* schema, size_t key_col, size_t level,
+                             PartitionOutput& parts) {
+    std::unique_ptr<BlockSource> reader = openReader(input_file, read_stats);
+    Block input_block(block_size);
+
+    while (reader->readBlock(&input_block)) {
+        RecordReader rec_reader(&input_block, schema);
 
         while (rec_reader.hasNext()) {
-            Record record = rec_reader.readNext();
+            RecordView record = rec_reader.readNext();
+            parts.append(partitionHash(record.getInt(key_col), level) % parts.size(), record);
+        }
 
-            // 조인 키 값 추출
-            int_t key = getJoinKeyValue(record, build_table_type);
+        input_block.clear();
+    }
+
+    parts.finish();
+}
+
+void HashJoin::graceJoin(const std::string& build_file, const std::string& probe_file,
+                         size_t build_blocks, size_t level, const std::string& path,
+                         Statistics* read_stats, BlockSink& writer, Block& output_block) {
+    // 예산 안에 들어가면 이 쌍은 바로 메모리 조인
+    if (fitsInMemory(build_blocks)) {
+        clearHashTable();
+        buildHashTable(*openReader(build_file, read_stats), 0);
+        probeAndJoin(*openReader(probe_file, read_stats), writer, output_block);
+        return;
+    }
+
+    if (level >= MAX_GRACE_DEPTH) {
+        chunkedJoin(build_file, probe_file, read_stats, writer, output_block);
+        return;
+    }
+
+    // ========== 분할: 두 입력을 같은 해시로 fanout개 파일에 나눔 ==========
+    size_t fanout = chooseFanout(build_blocks);
+    max_fanout = std::max(max_fanout, fanout);
+    max_depth = std::max(max_depth, level + 1);
+    partitions_created += fanout;
+
+    TempFileSet temp_files;
+    PartitionOutput build_parts(partitionFileNames("build", path, fanout), block_size, &spill_stats);
+    PartitionOutput probe_parts(partitionFileNames("probe", path, fanout), block_size, &spill_stats);
+    for (size_t p = 0; p < fanout; ++p) {
+        temp_files.names.push_back(build_parts.file(p));
+        temp_files.names.push_back(probe_parts.file(p));
+    }
+
+    partitionFile(build_file, read_stats, build_schema, build_key_col, level, build_parts);
+    partitionFile(probe_file, read_stats, probe_schema, probe_key_col, level, probe_parts);
+
+    // ========== 파티션 쌍 조인 ==========
+    std::vector<bool> resident(fanout, false);
+    joinSpilledPartitions(build_parts, probe_parts, resident, build_blocks, level, path,
+                          writer, output_block);
+}
+
+void HashJoin::joinSpilledPartitions(const PartitionOutput& build_parts,
+                                     const PartitionOutput& probe_parts,
+                                     const std::vector<bool>& resident,
+                                     size_t parent_blocks, size_t level, const std::string& path,
+                                     BlockSink& writer, Block& output_block) {
+    // 최상위 분할이면 파티션별 스필 통계 기록
+    if (level == 0) {
+        partition_stats.assign(build_parts.size(), PartitionSpillStats());
+    }
+
+    for (size_t p = 0; p < build_parts.size(); ++p) {
+        size_t spill_reads_before = spill_stats.block_reads;
+        size_t spill_writes_before = spill_stats.block_writes;
 
-            // 해시 테이블에 레코드 추가
-            hash_table[key].push_back(record);
-            records_loaded++;
+        // Resident 파티션은 이미 조인됨, 한쪽이 비어 있으면 매칭될 레코드가 없음
+        bool skip = resident[p] ||
+                    build_parts.block_counts[p] == 0 || probe_parts.block_counts[p] == 0;
+
+        if (!skip && build_parts.block_counts[p] >= parent_blocks) {
+            // 분할해도 줄지 않음 (대부분 같은 키) → 재분할해도 소용없음
+            chunkedJoin(build_parts.file(p), probe_parts.file(p), &spill_stats,
+                        writer, output_block);
+        } else if (!skip) {
+            graceJoin(build_parts.file(p), probe_parts.file(p), build_parts.block_counts[p],
+                      level + 1, partitionId(path, p), &spill_stats, writer, output_block);
         }
 
-        block.clear();
+        if (level == 0) {
+            PartitionSpillStats& ps = partition_stats[p];
+            ps.resident = resident[p];
+            ps.build_records = build_parts.record_counts[p];
+            ps.probe_records = probe_parts.record_counts[p];
+            ps.build_blocks = build_parts.block_counts[p];
+            ps.probe_blocks = probe_parts.block_counts[p];
+            ps.spill_reads = spill_stats.block_reads - spill_reads_before;
+            ps.spill_writes = ps.build_blocks + ps.probe_blocks +
+                              (spill_stats.block_writes - spill_writes_before);
+        }
     }
+}
+
+void HashJoin::chunkedJoin(const std::string& build_file, const std::string& probe_file,
+                           Statistics* read_stats, BlockSink& writer, Block& output_block) {
+    chunked_partitions++;
 
-    std::cout << "Hash table built: " << records_loaded << " records, "
-              << hash_table.size() << " unique keys" << std::endl;
+    size_t chunk_blocks = std::max<size_t>(
+        1, static_cast<size_t>(memory_limit / (block_size * HASH_TABLE_OVERHEAD)));
+
+    // Build 입력을 chunk_blocks씩 해시 테이블에 올리고 청크마다 Probe 입력 전체 스캔
+    std::unique_ptr<BlockSource> build_reader = openReader(build_file, read_stats);
+    while (true) {
+        clearHashTable();
+        if (buildHashTable(*build_reader, chunk_blocks) == 0) {
+            break;
+        }
+
+        probeAndJoin(*openReader(probe_file, read_stats), writer, output_block);
+    }
+    clearHashTable();
 }
 
-void HashJoin::probeAndJoin(TableWriter& writer) {
-    std::cout << "Probing " << probe_table_file << "..." << std::endl;
+// ============================================================================
+// Hybrid Hash Join
+// ============================================================================
 
-    TableReader reader(probe_table_file, block_size, &stats);
-    Block input_block(block_size);
-    Block output_block(block_size);
-    RecordWriter output_writer(&output_block);
+void HashJoin::spillResidentPartition(size_t p, size_t fanout, PartitionOutput& build_parts) {
+    // 해시 테이블에서 파티션 p의 키를 모두 꺼내 임시 파일로 이동
+    const Schema* schema = build_schema;
+    hash_table.removeKeys(
+        [p, fanout](int_t key) { return partitionHash(key, 0) % fanout == p; },
+        [p, schema, &build_parts](int_t, const char* data, size_t size) {
+            build_parts.append(p, RecordView(schema, data, size));
+        });
+}
 
-    size_t probed_records = 0;
+void HashJoin::hybridJoin(BlockSink& writer, Block& output_block) {
+    // 파티션을 잘게 나눌수록 스필 단위가 작아져 예산을 더 꽉 채워 남길 수 있음
+    // (스필된 파티션마다 출력 블록 1개가 필요하므로 예산 내 블록 수로 제한)
+    size_t fanout = std::min(chooseFanout(build_table_blocks) * HYBRID_FANOUT_FACTOR,
+                             std::min(MAX_GRACE_FANOUT, maxPartitionFanout()));
+    max_fanout = fanout;
+    max_depth = 1;
+    partitions_created += fanout;
 
-    // Probe 테이블을 스캔하며 해시 테이블에서 매칭
-    while (reader.readBlock(&input_block)) {
-        RecordReader rec_reader(&input_block);
+    TempFileSet temp_files;
+    PartitionOutput build_parts(partitionFileNames("build", "", fanout), block_size, &spill_stats);
+    PartitionOutput probe_parts(partitionFileNames("probe", "", fanout), block_size, &spill_stats);
+    for (size_t p = 0; p < fanout; ++p) {
+        temp_files.names.push_back(build_parts.file(p));
+        temp_files.names.push_back(probe_parts.file(p));
+    }
 
-        while (rec_reader.hasNext()) {
-            Record probe_record = rec_reader.readNext();
-            probed_records++;
+    // 처음에는 모든 파티션이 resident, 예산을 넘으면 번호가 큰 파티션부터 스필
+    std::vector<bool> resident(fanout, true);
+    size_t resident_count = fanout;
 
-            // Probe 레코드의 조인 키 값 추출
-            int_t probe_key = getJoinKeyValue(probe_record, probe_table_type);
+    // ========== Build: resident 파티션은 해시 테이블로, 나머지는 임시 파일로 ==========
+    // arena는 자랄 때 복사하지 않으므로 미리 잡지 않고 사용량만큼 청크를 늘림
+    // (잡아 둔 메모리 ≤ 사용량 + 청크 하나, 스필로 비게 된 청크는 바로 해제)
+    clearHashTable();
+    {
+        std::unique_ptr<BlockSource> build_reader = openReader(build_table_file, &stats);
+        Block input_block(block_size);
 
-            // 해시 테이블에서 매칭되는 레코드 찾기
-            auto it = hash_table.find(probe_key);
+        while (build_reader->readBlock(&input_block)) {
+            RecordReader rec_reader(&input_block, build_schema);
 
-            if (it != hash_table.end()) {
-                // 매칭되는 모든 Build 레코드와 조인
-                for (const auto& build_record : it->second) {
-                    // 레코드 병합
-                    Record result;
+            while (rec_reader.hasNext()) {
+                RecordView record = rec_reader.readNext();
+                int_t key = record.getInt(build_key_col);
+                size_t p = partitionHash(key, 0) % fanout;
 
-                    // Build 레코드 필드 추가
-                    for (size_t i = 0; i < build_record.getFieldCount(); ++i) {
-                        result.addField(build_record.getField(i));
-                    }
+                if (!resident[p]) {
+                    build_parts.append(p, record);
+                    continue;
+                }
 
-                    // Probe 레코드 필드 추가
-                    for (size_t i = 0; i < probe_record.getFieldCount(); ++i) {
-                        result.addField(probe_record.getField(i));
-                    }
+                insertBuildRecord(key, record);
+                build_parts.record_counts[p]++;
+
+                // 해시 테이블 + 입력/출력 블록 + 스필 파티션 버퍼/창 블록이 예산을 넘으면 스필
+                while (resident_count > 0 &&
+                       hash_table.getMemoryUsage() + (2 + build_parts.bufferBlocks()) * block_size >
+                           memory_limit) {
+                    size_t victim = fanout;
+                    while (!resident[--victim]) {}
+
+                    resident[victim] = false;
+                    resident_count--;
+                    build_parts.record_counts[victim] = 0;
+                    spillResidentPartition(victim, fanout, build_parts);
+                }
+            }
+
+            input_block.clear();
+        }
+        peak_hash_memory = std::max(peak_hash_memory, hash_table.getMemoryUsage());
+    }
+    build_parts.finish();
+
+    std::cout << "Resident partitions: " << resident_count << " / " << fanout
+              << " (" << hash_table.getKeyCount() << " keys in memory)" << std::endl;
+
+    // ========== Probe: resident 파티션은 즉시 조인, 나머지는 임시 파일로 ==========
+    {
+        std::unique_ptr<BlockSource> probe_reader = openReader(probe_table_file, &stats);
+        Block input_block(block_size);
+
+        while (probe_reader->readBlock(&input_block)) {
+            RecordReader rec_reader(&input_block, probe_schema);
+
+            while (rec_reader.hasNext()) {
+                RecordView probe_record = rec_reader.readNext();
+                int_t key = probe_record.getInt(probe_key_col);
+                size_t p = partitionHash(key, 0) % fanout;
+
+                if (!resident[p]) {
+                    probe_parts.append(p, probe_record);
+                    continue;
+                }
+
+                probe_records++;
+                probe_parts.record_counts[p]++;
+                probeKey(key, probe_record, writer, output_block);
+            }
+
+            input_block.clear();
+        }
+    }
+    probe_parts.finish();
+    clearHashTable();
+
+    // ========== 스필된 파티션 쌍은 Grace 방식으로 조인 ==========
+    joinSpilledPartitions(build_parts, probe_parts, resident, build_table_blocks, 0, "",
+                          writer, output_block);
+}
+
+// ============================================================================
+// 병렬 Hash Join (in-memory 모드)
+// ============================================================================
+
+// 파티션 구축 전에 모아 두는 Build 레코드 참조 (블록 데이터를 가리킴)
+struct StagedRecord {
+    int_t key;
+    uint32_t size;
+    const char* data;
+};
+
+void HashJoin::parallelJoin(BlockSink& writer) {
+    size_t thread_count = num_threads;
+    size_t partition_count = thread_count * PARTITIONS_PER_THREAD;
+    thread_stats.assign(thread_count, Statistics());
+
+    std::cout << "Parallel hash join: " << thread_count << " threads, "
+              << partition_count << " build partitions" << std::endl;
+
+    // 모어셀은 페이지 번호로 나눠 읽으므로 정확한 페이지 수가 필요
+    // (.tbl이면 페이지 색인을 여기서 만들고, 스레드별 리더는 공유 색인을 씀)
+    build_table_blocks =
+        openTableSource(build_table_file, build_table_type, block_size, nullptr)->getBlockCount();
+    probe_table_blocks =
+        openTableSource(probe_table_file, probe_table_type, block_size, nullptr)->getBlockCount();
+
+    // ========== 1. Build 블록을 모어셀 단위로 읽고 파티션별로 분배 ==========
+    std::vector<Block> build_blocks;
+    build_blocks.reserve(build_table_blocks);
+    for (size_t i = 0; i < build_table_blocks; ++i) {
+        build_blocks.emplace_back(block_size);
+    }
+
+    // staged[thread][partition]: 스레드가 읽은 레코드를 잠금 없이 모음
+    std::vector<std::vector<std::vector<StagedRecord>>> staged(
+        thread_count, std::vector<std::vector<StagedRecord>>(partition_count));
+    std::atomic<size_t> next_block(0);
+
+    runParallel(thread_count, [&](size_t t) {
+        // 모어셀마다 위치를 옮기므로 .tbl 입력은 스레드당 파싱 작업 하나만 앞서 돌림
+        std::unique_ptr<BlockSource> reader_ptr =
+            openTableSource(build_table_file, build_table_type, block_size, &thread_stats[t], 1);
+        BlockSource& reader = *reader_ptr;
+
+        while (true) {
+            size_t begin = next_block.fetch_add(MORSEL_BLOCKS);
+            if (begin >= build_table_blocks) break;
+            size_t end = std::min(begin + MORSEL_BLOCKS, build_table_blocks);
+
+            for (size_t page = begin; page < end; ++page) {
+                reader.readBlockAt(page, &build_blocks[page]);
+
+                RecordReader rec_reader(&build_blocks[page], build_schema);
+                while (rec_reader.hasNext()) {
+                    RecordView record = rec_reader.readNext();
+                    int_t key = record.getInt(build_key_col);
+                    StagedRecord ref = {key, static_cast<uint32_t>(record.getSize()),
+                                        record.getData()};
+                    staged[t][partitionHash(key, 0) % partition_count].push_back(ref);
+                }
+            }
+        }
+    });
+
+    // ========== 2. 파티션마다 독립된 해시 테이블 구축 ==========
+    std::vector<FlatHashTable> tables(partition_count);
+    std::atomic<size_t> next_partition(0);
+
+    runParallel(thread_count, [&](size_t) {
+        while (true) {
+            size_t p = next_partition.fetch_add(1);
+            if (p >= partition_count) break;
+
+            size_t records = 0;
+            size_t bytes = 0;
+            for (size_t t = 0; t < thread_count; ++t) {
+                for (const StagedRecord& ref : staged[t][p]) {
+                    bytes += ref.size;
+                }
+                records += staged[t][p].size();
+            }
+
+            tables[p].reserve(records, bytes);
+            for (size_t t = 0; t < thread_count; ++t) {
+                for (const StagedRecord& ref : staged[t][p]) {
+                    tables[p].insert(ref.key, ref.data, ref.size);
+                }
+            }
+        }
+    });
+
+    size_t table_memory = 0;
+    size_t key_count = 0;
+    for (const FlatHashTable& table : tables) {
+        table_memory += table.getMemoryUsage();
+        key_count += table.getKeyCount();
+        build_records += table.getRecordCount();
+    }
+    peak_hash_memory = table_memory + build_blocks.size() * block_size;
+
+    // 레코드는 테이블 arena로 복사되었으므로 원본 블록과 분배 목록 해제
+    std::vector<Block>().swap(build_blocks);
+    std::vector<std::vector<std::vector<StagedRecord>>>().swap(staged);
+
+    std::cout << "Hash tables built: " << build_records << " records, "
+              << key_count << " unique keys" << std::endl;
 
-                    // 결과 쓰기
-                    if (!output_writer.writeRecord(result)) {
-                        writer.writeBlock(&output_block);
-                        output_block.clear();
+    // ========== 3. 모어셀 단위 병렬 probe ==========
+    std::mutex writer_mutex;
+    std::atomic<size_t> next_probe_block(0);
+    std::vector<size_t> thread_probed(thread_count, 0);
 
-                        if (!output_writer.writeRecord(result)) {
-                            throw std::runtime_error("Result record too large for block");
+    runParallel(thread_count, [&](size_t t) {
+        Statistics& local = thread_stats[t];
+        std::unique_ptr<BlockSource> reader_ptr =
+            openTableSource(probe_table_file, probe_table_type, block_size, &local, 1);
+        BlockSource& reader = *reader_ptr;
+        Block input_block(block_size);
+        Block output_block(block_size);
+        RecordWriter output_writer(&output_block);
+
+        // 출력 블록이 가득 찼을 때만 잠금을 잡고 공용 파일에 기록
+        auto flush = [&]() {
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            writer.flushBlock(&output_block);
+        };
+
+        while (true) {
+            size_t begin = next_probe_block.fetch_add(MORSEL_BLOCKS);
+            if (begin >= probe_table_blocks) break;
+            size_t end = std::min(begin + MORSEL_BLOCKS, probe_table_blocks);
+
+            for (size_t page = begin; page < end; ++page) {
+                reader.readBlockAt(page, &input_block);
+                RecordReader rec_reader(&input_block, probe_schema);
+
+                while (rec_reader.hasNext()) {
+                    RecordView probe_record = rec_reader.readNext();
+                    int_t key = probe_record.getInt(probe_key_col);
+                    const FlatHashTable& table = tables[partitionHash(key, 0) % partition_count];
+                    thread_probed[t]++;
+
+                    for (uint32_t e = table.find(key); e != FlatHashTable::NONE;
+                         e = table.next(e)) {
+                        RecordView build_record(build_schema, table.payload(e),
+                                                table.payloadSize(e));
+
+                        if (!output_writer.writeJoined(&output_schema, build_record,
+                                                       probe_record)) {
+                            flush();
+                            if (!output_writer.writeJoined(&output_schema, build_record,
+                                                           probe_record)) {
+                                throw std::runtime_error("Result record too large for block");
+                            }
                         }
+                        local.output_records++;
                     }
-
-                    stats.output_records++;
                 }
             }
         }
 
-        input_block.clear();
+        if (!output_block.isEmpty()) {
+            flush();
+        }
+    });
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        probe_records += thread_probed[t];
     }
+    std::cout << "Probed " << probe_records << " records" << std::endl;
+}
 
-    // 마지막 출력 블록 플러시
-    if (!output_block.isEmpty()) {
-        writer.writeBlock(&output_block);
+// ============================================================================
+// Radix Hash Join
+// ============================================================================
+
+// 메모리에 올린 입력: 블록, 레코드 뷰, 분할 대상 (키, 행 번호) 배열
+struct RadixInput {
+    std::vector<Block> blocks;
+    std::vector<RecordView> rows;
+    std::vector<int_t> keys;
+    std::vector<uint32_t> row_ids;
+    std::vector<size_t> bounds;     // 파티션 p = [bounds[p], bounds[p+1])
+};
+
+static void loadRadixInput(const std::string& file, const std::string& table_type,
+                           size_t block_size, Statistics* stats,
+                           const Schema* schema, size_t key_col, RadixInput& in) {
+    std::unique_ptr<BlockSource> reader_ptr = openTableSource(file, table_type, block_size, stats);
+    BlockSource& reader = *reader_ptr;
+    in.blocks.reserve(reader.getBlockCount());
+
+    // 메타데이터가 있으면 키 배열도 정확한 크기로 미리 할당
+    TableMetadata meta;
+    if (TableMetadata::load(file, meta)) {
+        in.keys.reserve(meta.record_count);
+        in.row_ids.reserve(meta.record_count);
+        in.rows.reserve(meta.record_count);
+    }
+
+    Block block(block_size);
+    while (reader.readBlock(&block)) {
+        in.blocks.push_back(std::move(block));
+        block = Block(block_size);
     }
 
-    std::cout << "Probed " << probed_records << " records" << std::endl;
+    // 블록 데이터는 이동해도 주소가 바뀌지 않으므로 뷰는 모두 읽은 뒤 만듦
+    for (const Block& loaded : in.blocks) {
+        RecordReader rec_reader(&loaded, schema);
+        while (rec_reader.hasNext()) {
+            RecordView record = rec_reader.readNext();
+            in.keys.push_back(record.getInt(key_col));
+            in.row_ids.push_back(static_cast<uint32_t>(in.rows.size()));
+            in.rows.push_back(record);
+        }
+    }
+}
+
+// keys/rows[0..n)를 키 해시의 [shift, shift + bits) 비트로 out에 분할
+// 각 파티션의 시작 위치(base 기준)를 bounds에 추가
+static void radixScatter(const int_t* keys, const uint32_t* rows, size_t n,
+                         size_t shift, size_t bits, size_t base,
+                         int_t* out_keys, uint32_t* out_rows, std::vector<size_t>& bounds) {
+    size_t fanout = static_cast<size_t>(1) << bits;
+    uint32_t mask = static_cast<uint32_t>(fanout - 1);
+
+    // 히스토그램 → 누적합으로 파티션별 쓰기 위치 결정
+    std::vector<size_t> pos(fanout + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        pos[((partitionHash(keys[i], 0) >> shift) & mask) + 1]++;
+    }
+    for (size_t p = 0; p < fanout; ++p) {
+        pos[p + 1] += pos[p];
+        bounds.push_back(base + pos[p]);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        size_t dst = pos[(partitionHash(keys[i], 0) >> shift) & mask]++;
+        out_keys[dst] = keys[i];
+        out_rows[dst] = rows[i];
+    }
+}
+
+// 1패스 또는 2패스 분할 (2패스면 첫 패스 파티션마다 다음 비트로 다시 나눔)
+static void radixPartition(RadixInput& in, size_t pass1_bits, size_t pass2_bits) {
+    size_t n = in.keys.size();
+    in.bounds.clear();
+
+    if (pass1_bits == 0) {
+        in.bounds.push_back(0);
+        in.bounds.push_back(n);
+        return;
+    }
+
+    std::vector<int_t> tmp_keys(n);
+    std::vector<uint32_t> tmp_rows(n);
+
+    if (pass2_bits == 0) {
+        radixScatter(in.keys.data(), in.row_ids.data(), n, 0, pass1_bits, 0,
+                     tmp_keys.data(), tmp_rows.data(), in.bounds);
+        in.keys.swap(tmp_keys);
+        in.row_ids.swap(tmp_rows);
+    } else {
+        std::vector<size_t> coarse;
+        radixScatter(in.keys.data(), in.row_ids.data(), n, 0, pass1_bits, 0,
+                     tmp_keys.data(), tmp_rows.data(), coarse);
+        coarse.push_back(n);
+
+        for (size_t c = 0; c + 1 < coarse.size(); ++c) {
+            radixScatter(tmp_keys.data() + coarse[c], tmp_rows.data() + coarse[c],
+                         coarse[c + 1] - coarse[c], pass1_bits, pass2_bits, coarse[c],
+                         in.keys.data() + coarse[c], in.row_ids.data() + coarse[c], in.bounds);
+        }
+    }
+
+    in.bounds.push_back(n);
+}
+
+void HashJoin::chooseRadixBits(size_t build_tuples, size_t& pass1_bits, size_t& pass2_bits) const {
+    size_t bits = radix_bits;
+
+    // 자동: Build 파티션 하나가 캐시 절반에 들어갈 때까지 비트 수 증가
+    if (bits == 0) {
+        double target = cache_size / 2.0;
+        while (bits < RADIX_MAX_BITS &&
+               static_cast<double>(build_tuples) * RADIX_TUPLE_FOOTPRINT >
+                   target * static_cast<double>(static_cast<size_t>(1) << bits)) {
+            bits++;
+        }
+    }
+    bits = std::min(bits, RADIX_MAX_BITS);
+
+    // 한 패스의 fanout이 너무 크면 TLB 미스가 나므로 두 패스로 나눔
+    if (bits <= RADIX_MAX_BITS_PER_PASS) {
+        pass1_bits = bits;
+        pass2_bits = 0;
+    } else {
+        pass1_bits = (bits + 1) / 2;
+        pass2_bits = bits / 2;
+    }
+}
+
+void HashJoin::radixJoin(BlockSink& writer, Block& output_block) {
+    RadixInput build;
+    RadixInput probe;
+    loadRadixInput(build_table_file, build_table_type, block_size, &stats,
+                   build_schema, build_key_col, build);
+    loadRadixInput(probe_table_file, probe_table_type, block_size, &stats,
+                   probe_schema, probe_key_col, probe);
+    build_records = build.keys.size();
+    probe_records = probe.keys.size();
+
+    size_t pass1_bits, pass2_bits;
+    chooseRadixBits(build.keys.size(), pass1_bits, pass2_bits);
+    radix_passes = (pass1_bits > 0 ? 1 : 0) + (pass2_bits > 0 ? 1 : 0);
+    radix_fanout = static_cast<size_t>(1) << (pass1_bits + pass2_bits);
+
+    std::cout << "Radix partitioning: " << radix_fanout << " partitions in " << radix_passes
+              << " pass(es), cache target " << (cache_size / 1024) << " KB" << std::endl;
+
+    // ========== 분할 ==========
+    auto start = std::chrono::high_resolution_clock::now();
+    radixPartition(build, pass1_bits, pass2_bits);
+    radixPartition(probe, pass1_bits, pass2_bits);
+    auto partitioned = std::chrono::high_resolution_clock::now();
+    partition_time = std::chrono::duration<double>(partitioned - start).count();
+
+    // ========== 파티션별 build/probe ==========
+    ChunkHashIndex index;
+    SelectionVector selection;
+    size_t index_memory = 0;
+
+    for (size_t p = 0; p < radix_fanout; ++p) {
+        size_t build_begin = build.bounds[p];
+        size_t build_n = build.bounds[p + 1] - build_begin;
+        size_t probe_begin = probe.bounds[p];
+        size_t probe_n = probe.bounds[p + 1] - probe_begin;
+        if (build_n == 0 || probe_n == 0) {
+            continue;
+        }
+
+        index.build(build.keys.data() + build_begin, build_n);
+        index_memory = std::max(index_memory, index.getMemoryUsage());
+
+        selection.clear();
+        index.probeBlock(probe.keys.data() + probe_begin, probe_n, selection);
+
+        for (size_t k = 0; k < selection.size(); ++k) {
+            const RecordView& build_record =
+                build.rows[build.row_ids[build_begin + selection.outer_idx[k]]];
+            const RecordView& probe_record =
+                probe.rows[probe.row_ids[probe_begin + selection.inner_idx[k]]];
+            emitJoined(build_record, probe_record, writer, output_block);
+        }
+    }
+    join_time = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - partitioned).count();
+
+    // 두 입력의 블록 + 레코드 뷰 + (키, 행 번호) 배열 (분할 중 임시 배열 포함) + 파티션 인덱스
+    size_t tuples = build.keys.size() + probe.keys.size();
+    peak_hash_memory = (build.blocks.size() + probe.blocks.size()) * block_size +
+                       tuples * (sizeof(RecordView) + 2 * (sizeof(int_t) + sizeof(uint32_t))) +
+                       index_memory;
 }
 
 void HashJoin::execute() {
@@ -189,32 +945,211 @@ void HashJoin::execute() {
     std::cout << "Join Key: " << join_key << std::endl;
     std::cout << "Output: " << output_file << std::endl;
 
-    // Build Phase
-    buildHashTable();
+    bool partitioned = (mode == HashJoinMode::GRACE || mode == HashJoinMode::HYBRID);
+    if (partitioned) {
+        if (memory_limit < 3 * block_size) {
+            throw std::runtime_error("Memory limit too small for partitioned hash join (need at "
+                                     "least 3 blocks = " + std::to_string(3 * block_size) +
+                                     " bytes)");
+        }
+        std::cout << "Mode: " << (mode == HashJoinMode::GRACE ? "grace" : "hybrid")
+                  << " (memory limit " << (memory_limit / 1024.0 / 1024.0) << " MB)" << std::endl;
+    } else if (mode == HashJoinMode::RADIX) {
+        std::cout << "Mode: radix (cache target " << (cache_size / 1024) << " KB)" << std::endl;
+    } else {
+        std::cout << "Mode: in-memory" << std::endl;
+    }
+    if (num_threads > 1 && mode != HashJoinMode::IN_MEMORY) {
+        std::cout << "Note: --threads applies to in-memory mode; running single-threaded"
+                  << std::endl;
+    }
+
+    // 입력 크기 (블록 파일은 파일 크기로 결정되므로 읽기 없이 확인, .tbl은 텍스트 크기로
+    // 어림하므로 파티션 수를 정하려고 미리 파싱하지 않음)
+    build_table_blocks = estimateTableBlocks(build_table_file, build_table_type, block_size);
+    probe_table_blocks = estimateTableBlocks(probe_table_file, probe_table_type, block_size);
+
+    // write-behind이면 가득 찬 출력 블록을 백그라운드 스레드가 모아서 기록
+    std::unique_ptr<BlockSink> writer_ptr;
+    WriteBehindWriter* write_behind = nullptr;
+    if (write_behind_blocks > 0) {
+        write_behind = new WriteBehindWriter(output_file, block_size, write_behind_blocks, &stats);
+        writer_ptr.reset(write_behind);
+    } else {
+        writer_ptr.reset(new TableWriter(output_file, &stats));
+    }
+    BlockSink& writer = *writer_ptr;
+    Block output_block(block_size);
+
+    if (mode == HashJoinMode::GRACE) {
+        if (fitsInMemory(build_table_blocks)) {
+            std::cout << "Build table fits in memory limit; no partitioning needed" << std::endl;
+        }
+        graceJoin(build_table_file, probe_table_file, build_table_blocks, 0, "",
+                  &stats, writer, output_block);
+        clearHashTable();
+    } else if (mode == HashJoinMode::HYBRID) {
+        hybridJoin(writer, output_block);
+    } else if (mode == HashJoinMode::RADIX) {
+        radixJoin(writer, output_block);
+    } else if (num_threads > 1) {
+        parallelJoin(writer);
+    } else {
+        // Build Phase
+        std::cout << "Building hash table from " << build_table_file << "..." << std::endl;
+        TableMetadata build_meta;
+        if (TableMetadata::load(build_table_file, build_meta)) {
+            buildHashTable(*openReader(build_table_file, &stats), 0,
+                           build_meta.record_count, build_meta.record_bytes);
+        } else {
+            buildHashTable(*openReader(build_table_file, &stats), 0);
+        }
+        std::cout << "Hash table built: " << build_records << " records, "
+                  << hash_table.getKeyCount() << " unique keys" << std::endl;
+
+        // Probe Phase
+        std::cout << "Probing " << probe_table_file << "..." << std::endl;
+        probeAndJoin(*openReader(probe_table_file, &stats), writer, output_block);
+        std::cout << "Probed " << probe_records << " records" << std::endl;
+    }
+
+    // .tbl 입력은 끝까지 스캔하며 만든 색인이 있으면 통계용 페이지 수를 정확한 값으로
+    build_table_blocks = estimateTableBlocks(build_table_file, build_table_type, block_size);
+    probe_table_blocks = estimateTableBlocks(probe_table_file, probe_table_type, block_size);
+
+    // 마지막 출력 블록 플러시
+    if (!output_block.isEmpty()) {
+        writer.writeBlock(&output_block);
+    }
+    if (write_behind) {
+        write_behind->close();
+        output_write_calls = write_behind->getWriteCalls();
+        output_stall_time = write_behind->getStallTime();
+    }
 
-    // Probe Phase
-    TableWriter writer(output_file, &stats);
-    probeAndJoin(writer);
+    // 스레드별 통계와 임시 파티션 I/O를 전체 통계에 합산
+    for (const Statistics& local : thread_stats) {
+        stats.merge(local);
+    }
+    stats.spill_block_reads = spill_stats.block_reads;
+    stats.spill_block_writes = spill_stats.block_writes;
+    stats.block_reads += spill_stats.block_reads;
+    stats.block_writes += spill_stats.block_writes;
 
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = end_time - start_time;
     stats.elapsed_time = elapsed.count();
 
-    // 메모리 사용량 추정 (해시 테이블 + 블록)
-    size_t hash_memory = 0;
-    for (const auto& pair : hash_table) {
-        hash_memory += sizeof(int_t);  // 키
-        hash_memory += pair.second.size() * 100;  // 대략적인 레코드 크기
+    // 메모리 사용량 (최대 해시 테이블 + 스레드별 입력/출력 블록 + 분할 중 파티션 블록)
+    size_t io_blocks = 2 * std::max<size_t>(1, thread_stats.size()) +
+                       max_fanout * (1 + ioWindowBlocks(spillIoOptions()));
+    stats.memory_usage = peak_hash_memory + io_blocks * block_size;
+
+    // io_uring 창 (동시에 열리는 입력 리더: 순차 2개 또는 스레드마다 1개, 출력 라이터 1개)
+    size_t window = ioWindowBlocks(getDefaultIoOptions());
+    if (window > 0) {
+        size_t readers = scan_method == ScanMethod::READ
+                             ? (thread_stats.empty() ? 2 : thread_stats.size()) : 0;
+        size_t writers = write_behind_blocks > 0 ? 0 : 1;
+        stats.memory_usage += (readers + writers) * window * block_size;
+    }
+
+    // 미리 읽기 링 (동시에 열리는 순차 리더는 최대 2개; radix/병렬 모드는 미사용)
+    if (prefetch_depth > 0 && scan_method == ScanMethod::READ &&
+        mode != HashJoinMode::RADIX && thread_stats.empty()) {
+        stats.memory_usage += 2 * prefetch_depth * block_size;
     }
-    stats.memory_usage = hash_memory + 2 * block_size;
+    stats.memory_usage += write_behind_blocks * block_size;
 
+    printStatistics();
+}
+
+void HashJoin::printStatistics() const {
     std::cout << "\n=== Hash Join Statistics ===" << std::endl;
     std::cout << "Block Reads: " << stats.block_reads << std::endl;
     std::cout << "Block Writes: " << stats.block_writes << std::endl;
     std::cout << "Output Records: " << stats.output_records << std::endl;
     std::cout << "Elapsed Time: " << stats.elapsed_time << " seconds" << std::endl;
     std::cout << "Memory Usage: " << (stats.memory_usage / 1024.0 / 1024.0) << " MB" << std::endl;
-    std::cout << "Hash Table Size: " << hash_table.size() << " keys" << std::endl;
+    if (prefetch_depth > 0) {
+        std::cout << "I/O Stall Time: " << stats.io_stall_time << " seconds" << std::endl;
+    }
+    if (write_behind_blocks > 0) {
+        std::cout << "Write-Behind: " << write_behind_blocks << " pool blocks, "
+                  << output_write_calls << " pwritev calls ("
+                  << (output_write_calls > 0
+                          ? static_cast<double>(stats.block_writes - stats.spill_block_writes) /
+                                output_write_calls
+                          : 0.0)
+                  << " blocks/call)" << std::endl;
+        std::cout << "Output Stall Time: " << output_stall_time << " seconds" << std::endl;
+    }
+
+    if (mode == HashJoinMode::IN_MEMORY && !thread_stats.empty()) {
+        std::cout << "\nThread  Block Reads  Output Records" << std::endl;
+        for (size_t t = 0; t < thread_stats.size(); ++t) {
+            std::cout << std::setw(6) << t << std::setw(13) << thread_stats[t].block_reads
+                      << std::setw(16) << thread_stats[t].output_records << std::endl;
+        }
+        return;
+    }
+    if (mode == HashJoinMode::IN_MEMORY) {
+        std::cout << "Hash Table Size: " << hash_table.getKeyCount() << " keys" << std::endl;
+        return;
+    }
+    if (mode == HashJoinMode::RADIX) {
+        std::cout << "Radix Partitions: " << radix_fanout << " (" << radix_passes
+                  << " pass(es))" << std::endl;
+        std::cout << "Partition Time: " << partition_time << " seconds" << std::endl;
+        std::cout << "Build/Probe Time: " << join_time << " seconds" << std::endl;
+        return;
+    }
+
+    std::cout << "Spill Reads: " << stats.spill_block_reads << std::endl;
+    std::cout << "Spill Writes: " << stats.spill_block_writes << std::endl;
+    std::cout << "Partitions: " << partitions_created << " (max fanout " << max_fanout
+              << ", partitioning depth " << max_depth << ")" << std::endl;
+    if (chunked_partitions > 0) {
+        std::cout << "Chunked Partitions: " << chunked_partitions
+                  << " (could not be split below the memory limit)" << std::endl;
+    }
+
+    // 최상위 파티션별 스필 통계
+    size_t total_build = 0;
+    size_t resident_build = 0;
+    if (!partition_stats.empty()) {
+        std::cout << "\nPartition  Resident  Build Recs  Probe Recs  Spill Writes  Spill Reads"
+                  << std::endl;
+        for (size_t p = 0; p < partition_stats.size(); ++p) {
+            const PartitionSpillStats& ps = partition_stats[p];
+            std::cout << std::setw(9) << p << std::setw(10) << (ps.resident ? "yes" : "no")
+                      << std::setw(12) << ps.build_records << std::setw(12) << ps.probe_records
+                      << std::setw(14) << ps.spill_writes << std::setw(13) << ps.spill_reads
+                      << std::endl;
+
+            total_build += ps.build_records;
+            resident_build += ps.resident ? ps.build_records : 0;
+        }
+    }
+
+    // I/O 비교 (결과 쓰기 제외): BNLJ는 같은 메모리 예산 B = M / P 블록을 쓴다고 가정
+    size_t r = build_table_blocks;
+    size_t s = probe_table_blocks;
+    size_t b = memory_limit / block_size;
+    size_t bnlj_io = r + ((r + (b - 2)) / (b - 1)) * s;
+    size_t grace_io = 3 * (r + s);
+    size_t actual_io = stats.block_reads + stats.spill_block_writes;
+
+    std::cout << "\nI/O Cost (excluding result writes, B = " << b << " blocks):" << std::endl;
+    std::cout << "  Actual:                         " << actual_io << std::endl;
+    std::cout << "  Grace estimate 3(|R|+|S|):      " << grace_io << std::endl;
+    if (mode == HashJoinMode::HYBRID && total_build > 0) {
+        // q = 메모리에 남은 Build 비율
+        double q = static_cast<double>(resident_build) / total_build;
+        size_t hybrid_io = static_cast<size_t>((r + s) + 2.0 * (1.0 - q) * (r + s));
+        std::cout << "  Hybrid estimate (q = " << q << "):  " << hybrid_io << std::endl;
+    }
+    std::cout << "  BNLJ |R| + ceil(|R|/(B-1))|S|:  " << bnlj_io << std::endl;
 }
 
 // ============================================================================
@@ -0,0 +1,201 @@
+#include "prefetch_reader.h"
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+const size_t PrefetchReader::DEFAULT_DEPTH;
+const size_t PrefetchReader::SPIN_WAITS;
+
+PrefetchReader::PrefetchReader(const std::string& fname, size_t blk_size,
+                               size_t prefetch_depth, Statistics* st)
+    : reader(fname, blk_size),
+      block_size(blk_size),
+      depth(prefetch_depth),
+      stats(st),
+      head(0),
+      tail(0),
+      done(true),
+      stop(false),
+      producer_waiting(false),
+      consumer_waiting(false),
+      skipped(0) {
+
+    if (depth == 0) {
+        throw std::runtime_error("Prefetch depth must be at least 1");
+    }
+    for (size_t i = 0; i < depth; ++i) {
+        ring.emplace_back(block_size);
+    }
+
+    restart(0, reader.getBlockCount());
+}
+
+PrefetchReader::~PrefetchReader() {
+    stopThread();
+}
+
+// ============================================================================
+// I/O 스레드
+// ============================================================================
+
+void PrefetchReader::produce(size_t begin, size_t end) {
+    try {
+        bool positioned = false;
+        for (size_t page = begin; page < end; ++page) {
+            if (filter.skip(page)) {
+                skipped++;
+                positioned = false;
+                continue;
+            }
+            size_t h = head.load(std::memory_order_relaxed);
+
+            // 링이 가득 차면 소비자가 하나 꺼낼 때까지 대기 (잠깐 돈 뒤 잠듦)
+            for (size_t spin = 0; h - tail.load(std::memory_order_acquire) == depth; ++spin) {
+                if (stop.load(std::memory_order_relaxed)) return;
+                if (spin < SPIN_WAITS) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(wait_mutex);
+                producer_waiting.store(true);
+                not_full.wait(lock, [&] { return h - tail.load() != depth || stop.load(); });
+                producer_waiting.store(false);
+            }
+            if (stop.load(std::memory_order_relaxed)) return;
+
+            // 구간 첫 페이지와 건너뛴 페이지 다음만 위치 지정, 이후는 순차 읽기
+            Block* slot = &ring[h % depth];
+            if (!positioned) {
+                reader.readBlockAt(page, slot);
+                positioned = true;
+            } else {
+                reader.readBlock(slot);
+            }
+
+            // 슬롯 내용을 소비자에게 공개
+            head.store(h + 1);
+            wake(consumer_waiting, not_empty);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    done.store(true);
+    std::lock_guard<std::mutex> lock(wait_mutex);
+    not_empty.notify_all();
+}
+
+void PrefetchReader::wake(std::atomic<bool>& waiting, std::condition_variable& cv) {
+    // 카운터 store와 waiting load가 모두 seq_cst이므로, 잠드는 쪽이 waiting을 켠 뒤
+    // 조건을 다시 볼 때 새 카운터를 보거나, 여기서 waiting을 보고 깨우거나 둘 중 하나
+    if (waiting.load()) {
+        std::lock_guard<std::mutex> lock(wait_mutex);
+        cv.notify_one();
+    }
+}
+
+void PrefetchReader::collectSkipped() {
+    if (stats) {
+        stats->blocks_skipped += skipped;
+    }
+    skipped = 0;
+}
+
+void PrefetchReader::stopThread() {
+    if (io_thread.joinable()) {
+        stop.store(true);
+        {
+            std::lock_guard<std::mutex> lock(wait_mutex);
+            not_full.notify_all();
+        }
+        io_thread.join();
+    }
+}
+
+// ============================================================================
+// 소비자 인터페이스
+// ============================================================================
+
+bool PrefetchReader::readBlock(Block* block) {
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch in prefetch reader");
+    }
+
+    size_t t = tail.load(std::memory_order_relaxed);
+    bool stalled = false;
+    std::chrono::high_resolution_clock::time_point stall_start;
+
+    for (size_t spin = 0; head.load(std::memory_order_acquire) == t; ++spin) {
+        // done을 본 뒤 head를 다시 확인해야 마지막 블록을 놓치지 않음
+        if (done.load(std::memory_order_acquire) &&
+            head.load(std::memory_order_acquire) == t) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            collectSkipped();
+            return false;
+        }
+        if (!stalled) {
+            stalled = true;
+            stall_start = std::chrono::high_resolution_clock::now();
+        }
+        if (spin < SPIN_WAITS) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        consumer_waiting.store(true);
+        not_empty.wait(lock, [&] { return head.load() != t || done.load(); });
+        consumer_waiting.store(false);
+    }
+
+    if (stalled && stats) {
+        std::chrono::duration<double> waited =
+            std::chrono::high_resolution_clock::now() - stall_start;
+        stats->io_stall_time += waited.count();
+    }
+
+    // 채워진 슬롯과 호출자 블록의 버퍼 교환 후 슬롯 반환
+    std::swap(*block, ring[t % depth]);
+    tail.store(t + 1);
+    wake(producer_waiting, not_full);
+
+    if (stats) {
+        stats->block_reads++;
+    }
+    return true;
+}
+
+bool PrefetchReader::readBlockAt(size_t page_no, Block* block) {
+    if (page_no >= reader.getBlockCount()) {
+        return false;
+    }
+    restart(page_no, reader.getBlockCount());
+    return readBlock(block);
+}
+
+void PrefetchReader::reset() {
+    restart(0, reader.getBlockCount());
+}
+
+void PrefetchReader::restart(size_t begin, size_t end) {
+    stopThread();
+    collectSkipped();
+    filter = next_filter;
+
+    if (end > reader.getBlockCount()) {
+        end = reader.getBlockCount();
+    }
+
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    stop.store(false, std::memory_order_relaxed);
+    error = nullptr;
+
+    if (begin >= end) {
+        done.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    done.store(false, std::memory_order_relaxed);
+    io_thread = std::thread(&PrefetchReader::produce, this, begin, end);
+}
@@ -2,93 +2,227 @@
 #include <cstring>
 #include <stdexcept>
 
-std::vector<char> Record::serialize() const {
-    std::vector<char> buffer;
-
-    // 각 필드를 직렬화
-    for (const auto& field : fields) {
-        // 필드 길이 (2 bytes)
-        uint16_t field_len = static_cast<uint16_t>(field.size());
-        buffer.insert(buffer.end(),
-                      reinterpret_cast<const char*>(&field_len),
-                      reinterpret_cast<const char*>(&field_len) + sizeof(uint16_t));
-
-        // 필드 데이터
-        buffer.insert(buffer.end(), field.begin(), field.end());
+// ============================================================================
+// Record 구현
+// ============================================================================
+
+// 타입이 맞는 컬럼인지 확인
+static const Column& checkField(const Schema* schema, size_t idx, FieldType type) {
+    if (!schema || idx >= schema->getColumnCount()) {
+        throw std::out_of_range("Field index out of range: " + std::to_string(idx));
     }
+    const Column& col = schema->getColumn(idx);
+    if (col.type != type) {
+        throw std::runtime_error("Field type mismatch for column '" + col.name + "'");
+    }
+    return col;
+}
 
-    return buffer;
+int_t Record::getInt(size_t idx) const {
+    checkField(schema, idx, FieldType::INT);
+    return view().getInt(idx);
 }
 
-Record Record::deserialize(const char* data, size_t& offset) {
-    Record record;
-    size_t pos = offset;
+decimal_t Record::getDecimal(size_t idx) const {
+    checkField(schema, idx, FieldType::DECIMAL);
+    return view().getDecimal(idx);
+}
 
-    // 먼저 레코드 크기 읽기
-    uint32_t record_size;
-    std::memcpy(&record_size, data + pos, sizeof(uint32_t));
-    pos += sizeof(uint32_t);
+std::string Record::getString(size_t idx) const {
+    checkField(schema, idx, FieldType::STRING);
+    return view().getString(idx).str();
+}
 
-    size_t end_pos = pos + record_size;
+std::string Record::getFieldAsString(size_t idx) const {
+    switch (schema->getColumn(idx).type) {
+        case FieldType::INT:     return std::to_string(getInt(idx));
+        case FieldType::DECIMAL: return std::to_string(getDecimal(idx));
+        default:                 return getString(idx);
+    }
+}
 
-    // 필드들 읽기
-    while (pos < end_pos) {
-        // 필드 길이 읽기
-        uint16_t field_len;
-        std::memcpy(&field_len, data + pos, sizeof(uint16_t));
-        pos += sizeof(uint16_t);
+Record Record::deserialize(const Schema* schema, const char* data, size_t size) {
+    RecordView view(schema, data, size);
+    if (!view.isValid()) {
+        throw std::runtime_error("Corrupt " + schema->getTableType() + " record");
+    }
+    return view.materialize();
+}
+
+Record Record::concat(const Schema* result_schema, const Record& left, const Record& right) {
+    RecordView lv = left.view();
+    RecordView rv = right.view();
+
+    std::vector<char> out(RecordView::concatSize(result_schema, lv, rv));
+    RecordView::concatInto(out.data(), result_schema, lv, rv);
+    return Record(result_schema, std::move(out));
+}
+
+// ============================================================================
+// RecordView 구현
+// ============================================================================
 
-        // 필드 데이터 읽기
-        std::string field(data + pos, field_len);
-        record.addField(field);
-        pos += field_len;
+bool RecordView::isValid() const {
+    size_t header_size = schema->getHeaderSize();
+    if (size < header_size) {
+        return false;
     }
 
-    offset = pos;
-    return record;
+    // 문자열 끝 오프셋은 단조 증가하며 레코드 안에 있어야 함
+    const char* offsets = data + schema->getFixedSize();
+    size_t prev = header_size;
+    for (size_t k = 0; k < schema->getVarCount(); ++k) {
+        size_t end = loadLE16(offsets + k * sizeof(uint16_t));
+        if (end < prev || end > size) {
+            return false;
+        }
+        prev = end;
+    }
+    return true;
+}
+
+Record RecordView::materialize() const {
+    return Record(schema, std::vector<char>(data, data + size));
 }
 
-size_t Record::getSerializedSize() const {
-    size_t size = 0;
-    for (const auto& field : fields) {
-        size += sizeof(uint16_t) + field.size();
+size_t RecordView::concatSize(const Schema* result_schema,
+                              const RecordView& left, const RecordView& right) {
+    size_t total = result_schema->getHeaderSize() +
+                   (left.size - left.schema->getHeaderSize()) +
+                   (right.size - right.schema->getHeaderSize());
+
+    if (total > UINT16_MAX) {
+        throw std::runtime_error("Joined record too large: " + std::to_string(total) + " bytes");
     }
-    return size;
+    return total;
 }
 
-bool RecordReader::hasNext() const {
-    // Need at least 4 bytes for record size
-    if (current_offset + sizeof(uint32_t) > block->getUsedSize()) {
-        return false;
+void RecordView::concatInto(char* out, const Schema* result_schema,
+                            const RecordView& left, const RecordView& right) {
+    const Schema& ls = *left.schema;
+    const Schema& rs = *right.schema;
+
+    size_t l_strings = left.size - ls.getHeaderSize();
+    size_t r_strings = right.size - rs.getHeaderSize();
+    size_t header_size = result_schema->getHeaderSize();
+
+    // 고정 영역: left 고정 필드 뒤에 right 고정 필드
+    std::memcpy(out, left.data, ls.getFixedSize());
+    std::memcpy(out + ls.getFixedSize(), right.data, rs.getFixedSize());
+
+    // 오프셋 테이블: 새 헤더 크기 기준으로 이동
+    char* offsets = out + result_schema->getFixedSize();
+    size_t l_shift = header_size - ls.getHeaderSize();
+    for (size_t k = 0; k < ls.getVarCount(); ++k) {
+        size_t end = loadLE16(left.data + ls.getFixedSize() + k * sizeof(uint16_t));
+        storeLE16(offsets + k * sizeof(uint16_t), static_cast<uint16_t>(end + l_shift));
+    }
+    size_t r_shift = header_size + l_strings - rs.getHeaderSize();
+    for (size_t k = 0; k < rs.getVarCount(); ++k) {
+        size_t end = loadLE16(right.data + rs.getFixedSize() + k * sizeof(uint16_t));
+        storeLE16(offsets + (ls.getVarCount() + k) * sizeof(uint16_t),
+                  static_cast<uint16_t>(end + r_shift));
     }
 
-    // Check if we can read the full record
-    const char* data = block->getData();
-    uint32_t record_size;
-    std::memcpy(&record_size, data + current_offset, sizeof(uint32_t));
+    // 문자열 데이터
+    std::memcpy(out + header_size, left.data + ls.getHeaderSize(), l_strings);
+    std::memcpy(out + header_size + l_strings, right.data + rs.getHeaderSize(), r_strings);
+}
 
-    // Sanity check: record size should be reasonable (less than block size)
-    if (record_size == 0 || record_size > block->getSize()) {
-        return false;
+// ============================================================================
+// RecordBuilder 구현
+// ============================================================================
+
+RecordBuilder::RecordBuilder(const Schema* s)
+    : schema(s), fixed(s->getFixedSize(), 0), strings(s->getVarCount()) {}
+
+const Column& RecordBuilder::checkColumn(size_t idx, FieldType type) const {
+    return checkField(schema, idx, type);
+}
+
+void RecordBuilder::setInt(size_t idx, int_t value) {
+    const Column& col = checkColumn(idx, FieldType::INT);
+    storeLE32(fixed.data() + col.position, static_cast<uint32_t>(value));
+}
+
+void RecordBuilder::setDecimal(size_t idx, decimal_t value) {
+    const Column& col = checkColumn(idx, FieldType::DECIMAL);
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    storeLE32(fixed.data() + col.position, bits);
+}
+
+void RecordBuilder::setString(size_t idx, const std::string& value) {
+    const Column& col = checkColumn(idx, FieldType::STRING);
+    strings[col.position] = value;
+}
+
+Record RecordBuilder::build() const {
+    size_t header_size = schema->getHeaderSize();
+    size_t total = header_size;
+    for (const auto& str : strings) {
+        total += str.size();
     }
 
-    // Check if we have enough bytes for the complete record
-    size_t total_needed = current_offset + sizeof(uint32_t) + record_size;
-    return total_needed <= block->getUsedSize();
+    if (total > UINT16_MAX) {
+        throw std::runtime_error("Record too large: " + std::to_string(total) + " bytes");
+    }
+
+    std::vector<char> out(total);
+    std::memcpy(out.data(), fixed.data(), fixed.size());
+
+    char* offsets = out.data() + schema->getFixedSize();
+    size_t pos = header_size;
+    for (size_t k = 0; k < strings.size(); ++k) {
+        std::memcpy(out.data() + pos, strings[k].data(), strings[k].size());
+        pos += strings[k].size();
+        storeLE16(offsets + k * sizeof(uint16_t), static_cast<uint16_t>(pos));
+    }
+
+    return Record(schema, std::move(out));
 }
 
-Record RecordReader::readNext() {
+// ============================================================================
+// RecordReader / RecordWriter 구현
+// ============================================================================
+
+bool RecordReader::hasNext() const {
+    return current_slot < block->getRecordCount();
+}
+
+RecordView RecordReader::readNext() {
     if (!hasNext()) {
         throw std::runtime_error("No more records in block");
     }
 
-    const char* data = block->getData();
-    Record record = Record::deserialize(data, current_offset);
+    return readAt(current_slot++);
+}
+
+RecordView RecordReader::readAt(size_t slot_no) const {
+    size_t length;
+    const char* data = block->getRecord(slot_no, length);
+
+    RecordView view(schema, data, length);
+    if (!view.isValid()) {
+        throw std::runtime_error("Corrupt " + schema->getTableType() + " record in slot " +
+                                 std::to_string(slot_no));
+    }
+    return view;
+}
 
-    return record;
+bool RecordWriter::writeRecord(const RecordView& record) {
+    return block->append(record.getData(), record.getSize());
 }
 
-bool RecordWriter::writeRecord(const Record& record) {
-    std::vector<char> serialized = record.serialize();
-    return block->append(serialized.data(), serialized.size());
+bool RecordWriter::writeJoined(const Schema* result_schema,
+                               const RecordView& left, const RecordView& right) {
+    size_t size = RecordView::concatSize(result_schema, left, right);
+
+    char* dest = block->allocateRecord(size);
+    if (!dest) {
+        return false;
+    }
+
+    RecordView::concatInto(dest, result_schema, left, right);
+    return true;
 }
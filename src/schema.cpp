@@ -0,0 +1,94 @@
+#include "schema.h"
+#include <stdexcept>
+
+Schema::Schema(const std::string& type,
+               const std::vector<std::pair<std::string, FieldType>>& cols)
+    : table_type(type), fixed_size(0), var_count(0) {
+
+    for (const auto& col : cols) {
+        Column column;
+        column.name = col.first;
+        column.type = col.second;
+
+        if (column.type == FieldType::STRING) {
+            column.position = static_cast<uint16_t>(var_count++);
+        } else {
+            column.position = static_cast<uint16_t>(fixed_size);
+            fixed_size += sizeof(uint32_t);
+        }
+
+        columns.push_back(column);
+    }
+}
+
+const Schema& Schema::forTable(const std::string& table_type) {
+    const FieldType I = FieldType::INT;
+    const FieldType D = FieldType::DECIMAL;
+    const FieldType S = FieldType::STRING;
+
+    static const Schema part("PART", {
+        {"partkey", I}, {"name", S}, {"mfgr", S}, {"brand", S}, {"type", S},
+        {"size", I}, {"container", S}, {"retailprice", D}, {"comment", S}});
+    static const Schema partsupp("PARTSUPP", {
+        {"partkey", I}, {"suppkey", I}, {"availqty", I}, {"supplycost", D},
+        {"comment", S}});
+    static const Schema supplier("SUPPLIER", {
+        {"suppkey", I}, {"name", S}, {"address", S}, {"nationkey", I},
+        {"phone", S}, {"acctbal", D}, {"comment", S}});
+    static const Schema customer("CUSTOMER", {
+        {"custkey", I}, {"name", S}, {"address", S}, {"nationkey", I},
+        {"phone", S}, {"acctbal", D}, {"mktsegment", S}, {"comment", S}});
+    static const Schema orders("ORDERS", {
+        {"orderkey", I}, {"custkey", I}, {"orderstatus", S}, {"totalprice", D},
+        {"orderdate", S}, {"orderpriority", S}, {"clerk", S}, {"shippriority", I},
+        {"comment", S}});
+    static const Schema lineitem("LINEITEM", {
+        {"orderkey", I}, {"partkey", I}, {"suppkey", I}, {"linenumber", I},
+        {"quantity", D}, {"extendedprice", D}, {"discount", D}, {"tax", D},
+        {"returnflag", S}, {"linestatus", S}, {"shipdate", S}, {"commitdate", S},
+        {"receiptdate", S}, {"shipinstruct", S}, {"shipmode", S}, {"comment", S}});
+    static const Schema nation("NATION", {
+        {"nationkey", I}, {"name", S}, {"regionkey", I}, {"comment", S}});
+    static const Schema region("REGION", {
+        {"regionkey", I}, {"name", S}, {"comment", S}});
+
+    if (table_type == "PART") return part;
+    if (table_type == "PARTSUPP") return partsupp;
+    if (table_type == "SUPPLIER") return supplier;
+    if (table_type == "CUSTOMER") return customer;
+    if (table_type == "ORDERS") return orders;
+    if (table_type == "LINEITEM") return lineitem;
+    if (table_type == "NATION") return nation;
+    if (table_type == "REGION") return region;
+
+    throw std::runtime_error("Unknown table type: " + table_type);
+}
+
+Schema Schema::concat(const Schema& left, const Schema& right) {
+    std::vector<std::pair<std::string, FieldType>> cols;
+    for (const auto& col : left.columns) {
+        cols.push_back(std::make_pair(col.name, col.type));
+    }
+    for (const auto& col : right.columns) {
+        cols.push_back(std::make_pair(col.name, col.type));
+    }
+    return Schema(left.table_type + "+" + right.table_type, cols);
+}
+
+int Schema::findColumn(const std::string& name) const {
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+size_t Schema::getKeyColumn(const std::string& name) const {
+    int col = findColumn(name);
+    if (col < 0 || columns[col].type != FieldType::INT) {
+        throw std::runtime_error("Invalid join key '" + name + "' for table type '" +
+                                 table_type + "'");
+    }
+    return static_cast<size_t>(col);
+}
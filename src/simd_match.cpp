@@ -0,0 +1,167 @@
+#include "simd_match.h"
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DBSYS_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// 커널 구현
+// ============================================================================
+
+static size_t matchScalar(const int_t* keys, size_t n, int_t probe, uint32_t* out) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // 분기 없이 기록하고 일치할 때만 카운트 증가
+        out[count] = static_cast<uint32_t>(i);
+        count += (keys[i] == probe);
+    }
+    return count;
+}
+
+#ifdef DBSYS_X86
+
+// 비교 결과 비트마스크의 설정된 비트 위치들을 out에 기록
+static inline size_t emitMask(unsigned mask, size_t base, uint32_t* out, size_t count) {
+    while (mask) {
+        out[count++] = static_cast<uint32_t>(base + __builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+__attribute__((target("sse2")))
+static size_t matchSSE2(const int_t* keys, size_t n, int_t probe, uint32_t* out) {
+    const __m128i p = _mm_set1_epi32(probe);
+    size_t count = 0;
+    size_t i = 0;
+
+    // 4개씩 비교
+    for (; i + 4 <= n; i += 4) {
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(k, p))));
+        count = emitMask(mask, i, out, count);
+    }
+
+    // 나머지
+    for (; i < n; ++i) {
+        if (keys[i] == probe) out[count++] = static_cast<uint32_t>(i);
+    }
+    return count;
+}
+
+__attribute__((target("avx2")))
+static size_t matchAVX2(const int_t* keys, size_t n, int_t probe, uint32_t* out) {
+    const __m256i p = _mm256_set1_epi32(probe);
+    size_t count = 0;
+    size_t i = 0;
+
+    // 16개씩 (두 레지스터) 비교, 대부분 불일치이므로 OR로 먼저 걸러냄
+    for (; i + 16 <= n; i += 16) {
+        __m256i k0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        __m256i k1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i + 8));
+        __m256i e0 = _mm256_cmpeq_epi32(k0, p);
+        __m256i e1 = _mm256_cmpeq_epi32(k1, p);
+        if (_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1))) {
+            continue;
+        }
+        count = emitMask(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(e0))),
+                         i, out, count);
+        count = emitMask(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(e1))),
+                         i + 8, out, count);
+    }
+
+    // 8개씩
+    for (; i + 8 <= n; i += 8) {
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(k, p))));
+        count = emitMask(mask, i, out, count);
+    }
+
+    // 나머지
+    for (; i < n; ++i) {
+        if (keys[i] == probe) out[count++] = static_cast<uint32_t>(i);
+    }
+    return count;
+}
+
+#endif // DBSYS_X86
+
+// ============================================================================
+// KeyMatcher 구현
+// ============================================================================
+
+KeyMatcher::KeyMatcher(MatchKernel k) : kernel(k), match_fn(matchScalar) {
+    switch (kernel) {
+#ifdef DBSYS_X86
+        case MatchKernel::AVX2: match_fn = matchAVX2; break;
+        case MatchKernel::SSE2: match_fn = matchSSE2; break;
+#endif
+        default:
+            kernel = MatchKernel::SCALAR;
+            match_fn = matchScalar;
+            break;
+    }
+}
+
+MatchKernel KeyMatcher::detectKernel() {
+#ifdef DBSYS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return MatchKernel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return MatchKernel::SSE2;
+    }
+#endif
+    return MatchKernel::SCALAR;
+}
+
+MatchKernel KeyMatcher::parseKernel(const std::string& name) {
+    MatchKernel best = detectKernel();
+
+    if (name == "auto") return best;
+    if (name == "scalar") return MatchKernel::SCALAR;
+
+    MatchKernel requested;
+    if (name == "sse2") {
+        requested = MatchKernel::SSE2;
+    } else if (name == "avx2") {
+        requested = MatchKernel::AVX2;
+    } else {
+        throw std::runtime_error("Unknown SIMD kernel: " + name);
+    }
+
+    if (static_cast<int>(requested) > static_cast<int>(best)) {
+        throw std::runtime_error(std::string("SIMD kernel not supported on this CPU: ") + name);
+    }
+    return requested;
+}
+
+const char* KeyMatcher::kernelName(MatchKernel k) {
+    switch (k) {
+        case MatchKernel::AVX2: return "avx2";
+        case MatchKernel::SSE2: return "sse2";
+        default:                return "scalar";
+    }
+}
+
+void KeyMatcher::matchBlock(const int_t* outer_keys, size_t outer_n,
+                            const int_t* inner_keys, size_t inner_n,
+                            SelectionVector& sel) {
+    if (scratch.size() < outer_n) {
+        scratch.resize(outer_n);
+    }
+
+    for (size_t j = 0; j < inner_n; ++j) {
+        size_t hits = match_fn(outer_keys, outer_n, inner_keys[j], scratch.data());
+
+        for (size_t h = 0; h < hits; ++h) {
+            sel.outer_idx.push_back(scratch[h]);
+            sel.inner_idx.push_back(static_cast<uint32_t>(j));
+        }
+    }
+}
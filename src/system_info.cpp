@@ -0,0 +1,47 @@
+#include "system_info.h"
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// sysfs 캐시 항목 하나 읽기 ("1024K" 같은 크기 문자열 포함)
+static std::string readCacheAttr(int index, const char* attr) {
+    std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) +
+                       "/" + attr);
+    std::string value;
+    file >> value;
+    return value;
+}
+
+static size_t sysfsCacheSize(int level) {
+    for (int index = 0; index < 8; ++index) {
+        std::string lvl = readCacheAttr(index, "level");
+        if (lvl.empty()) break;
+        if (std::stoi(lvl) != level || readCacheAttr(index, "type") == "Instruction") continue;
+
+        std::string size = readCacheAttr(index, "size");
+        if (size.empty()) continue;
+
+        size_t bytes = std::stoul(size);
+        char unit = size.back();
+        if (unit == 'K') bytes <<= 10;
+        if (unit == 'M') bytes <<= 20;
+        return bytes;
+    }
+    return 0;
+}
+
+size_t detectCacheSize(int level) {
+    long bytes = -1;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+    switch (level) {
+        case 1: bytes = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+        case 2: bytes = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+        case 3: bytes = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+        default: break;
+    }
+#endif
+    if (bytes > 0) {
+        return static_cast<size_t>(bytes);
+    }
+    return sysfsCacheSize(level);
+}
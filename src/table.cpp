@@ -1,8 +1,22 @@
 #include "table.h"
+#include "parallel.h"
+#include "table_metadata.h"
+#include "tbl_parser.h"
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Helper function to trim whitespace from strings
 static std::string trim(const std::string& str) {
@@ -62,17 +76,18 @@ static int extract_supplier_key(const std::string& str, const std::string& field
 
 // PartRecord 구현
 Record PartRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(partkey));
-    fields.push_back(name);
-    fields.push_back(mfgr);
-    fields.push_back(brand);
-    fields.push_back(type);
-    fields.push_back(std::to_string(size));
-    fields.push_back(container);
-    fields.push_back(std::to_string(retailprice));
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("PART");
+    RecordBuilder builder(schema);
+    builder.setInt(0, partkey);
+    builder.setString(1, name);
+    builder.setString(2, mfgr);
+    builder.setString(3, brand);
+    builder.setString(4, type);
+    builder.setInt(5, size);
+    builder.setString(6, container);
+    builder.setDecimal(7, retailprice);
+    builder.setString(8, comment);
+    return builder.build();
 }
 
 PartRecord PartRecord::fromRecord(const Record& rec) {
@@ -80,15 +95,15 @@ PartRecord PartRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 9) {
         throw std::runtime_error("Invalid PART record: expected 9 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    part.partkey = safe_stoi(rec.getField(0), "PART.partkey");
-    part.name = rec.getField(1);
-    part.mfgr = rec.getField(2);
-    part.brand = rec.getField(3);
-    part.type = rec.getField(4);
-    part.size = safe_stoi(rec.getField(5), "PART.size");
-    part.container = rec.getField(6);
-    part.retailprice = safe_stof(rec.getField(7), "PART.retailprice");
-    part.comment = rec.getField(8);
+    part.partkey = rec.getInt(0);
+    part.name = rec.getString(1);
+    part.mfgr = rec.getString(2);
+    part.brand = rec.getString(3);
+    part.type = rec.getString(4);
+    part.size = rec.getInt(5);
+    part.container = rec.getString(6);
+    part.retailprice = rec.getDecimal(7);
+    part.comment = rec.getString(8);
     return part;
 }
 
@@ -120,13 +135,14 @@ PartRecord PartRecord::fromCSV(const std::string& line) {
 
 // PartSuppRecord 구현
 Record PartSuppRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(partkey));
-    fields.push_back(std::to_string(suppkey));
-    fields.push_back(std::to_string(availqty));
-    fields.push_back(std::to_string(supplycost));
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("PARTSUPP");
+    RecordBuilder builder(schema);
+    builder.setInt(0, partkey);
+    builder.setInt(1, suppkey);
+    builder.setInt(2, availqty);
+    builder.setDecimal(3, supplycost);
+    builder.setString(4, comment);
+    return builder.build();
 }
 
 PartSuppRecord PartSuppRecord::fromRecord(const Record& rec) {
@@ -134,11 +150,11 @@ PartSuppRecord PartSuppRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 5) {
         throw std::runtime_error("Invalid PARTSUPP record: expected 5 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    partsupp.partkey = safe_stoi(rec.getField(0), "PARTSUPP.partkey");
-    partsupp.suppkey = safe_stoi(rec.getField(1), "PARTSUPP.suppkey");
-    partsupp.availqty = safe_stoi(rec.getField(2), "PARTSUPP.availqty");
-    partsupp.supplycost = safe_stof(rec.getField(3), "PARTSUPP.supplycost");
-    partsupp.comment = rec.getField(4);
+    partsupp.partkey = rec.getInt(0);
+    partsupp.suppkey = rec.getInt(1);
+    partsupp.availqty = rec.getInt(2);
+    partsupp.supplycost = rec.getDecimal(3);
+    partsupp.comment = rec.getString(4);
     return partsupp;
 }
 
@@ -166,15 +182,16 @@ PartSuppRecord PartSuppRecord::fromCSV(const std::string& line) {
 
 // SupplierRecord 구현
 Record SupplierRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(suppkey));
-    fields.push_back(name);
-    fields.push_back(address);
-    fields.push_back(std::to_string(nationkey));
-    fields.push_back(phone);
-    fields.push_back(std::to_string(acctbal));
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("SUPPLIER");
+    RecordBuilder builder(schema);
+    builder.setInt(0, suppkey);
+    builder.setString(1, name);
+    builder.setString(2, address);
+    builder.setInt(3, nationkey);
+    builder.setString(4, phone);
+    builder.setDecimal(5, acctbal);
+    builder.setString(6, comment);
+    return builder.build();
 }
 
 SupplierRecord SupplierRecord::fromRecord(const Record& rec) {
@@ -182,13 +199,13 @@ SupplierRecord SupplierRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 7) {
         throw std::runtime_error("Invalid SUPPLIER record: expected 7 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    supplier.suppkey = safe_stoi(rec.getField(0), "SUPPLIER.suppkey");
-    supplier.name = rec.getField(1);
-    supplier.address = rec.getField(2);
-    supplier.nationkey = safe_stoi(rec.getField(3), "SUPPLIER.nationkey");
-    supplier.phone = rec.getField(4);
-    supplier.acctbal = safe_stof(rec.getField(5), "SUPPLIER.acctbal");
-    supplier.comment = rec.getField(6);
+    supplier.suppkey = rec.getInt(0);
+    supplier.name = rec.getString(1);
+    supplier.address = rec.getString(2);
+    supplier.nationkey = rec.getInt(3);
+    supplier.phone = rec.getString(4);
+    supplier.acctbal = rec.getDecimal(5);
+    supplier.comment = rec.getString(6);
     return supplier;
 }
 
@@ -218,16 +235,17 @@ SupplierRecord SupplierRecord::fromCSV(const std::string& line) {
 
 // CustomerRecord 구현
 Record CustomerRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(custkey));
-    fields.push_back(name);
-    fields.push_back(address);
-    fields.push_back(std::to_string(nationkey));
-    fields.push_back(phone);
-    fields.push_back(std::to_string(acctbal));
-    fields.push_back(mktsegment);
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("CUSTOMER");
+    RecordBuilder builder(schema);
+    builder.setInt(0, custkey);
+    builder.setString(1, name);
+    builder.setString(2, address);
+    builder.setInt(3, nationkey);
+    builder.setString(4, phone);
+    builder.setDecimal(5, acctbal);
+    builder.setString(6, mktsegment);
+    builder.setString(7, comment);
+    return builder.build();
 }
 
 CustomerRecord CustomerRecord::fromRecord(const Record& rec) {
@@ -235,14 +253,14 @@ CustomerRecord CustomerRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 8) {
         throw std::runtime_error("Invalid CUSTOMER record: expected 8 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    customer.custkey = safe_stoi(rec.getField(0), "CUSTOMER.custkey");
-    customer.name = rec.getField(1);
-    customer.address = rec.getField(2);
-    customer.nationkey = safe_stoi(rec.getField(3), "CUSTOMER.nationkey");
-    customer.phone = rec.getField(4);
-    customer.acctbal = safe_stof(rec.getField(5), "CUSTOMER.acctbal");
-    customer.mktsegment = rec.getField(6);
-    customer.comment = rec.getField(7);
+    customer.custkey = rec.getInt(0);
+    customer.name = rec.getString(1);
+    customer.address = rec.getString(2);
+    customer.nationkey = rec.getInt(3);
+    customer.phone = rec.getString(4);
+    customer.acctbal = rec.getDecimal(5);
+    customer.mktsegment = rec.getString(6);
+    customer.comment = rec.getString(7);
     return customer;
 }
 
@@ -273,17 +291,18 @@ CustomerRecord CustomerRecord::fromCSV(const std::string& line) {
 
 // OrdersRecord 구현
 Record OrdersRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(orderkey));
-    fields.push_back(std::to_string(custkey));
-    fields.push_back(orderstatus);
-    fields.push_back(std::to_string(totalprice));
-    fields.push_back(orderdate);
-    fields.push_back(orderpriority);
-    fields.push_back(clerk);
-    fields.push_back(std::to_string(shippriority));
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("ORDERS");
+    RecordBuilder builder(schema);
+    builder.setInt(0, orderkey);
+    builder.setInt(1, custkey);
+    builder.setString(2, orderstatus);
+    builder.setDecimal(3, totalprice);
+    builder.setString(4, orderdate);
+    builder.setString(5, orderpriority);
+    builder.setString(6, clerk);
+    builder.setInt(7, shippriority);
+    builder.setString(8, comment);
+    return builder.build();
 }
 
 OrdersRecord OrdersRecord::fromRecord(const Record& rec) {
@@ -291,15 +310,15 @@ OrdersRecord OrdersRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 9) {
         throw std::runtime_error("Invalid ORDERS record: expected 9 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    orders.orderkey = safe_stoi(rec.getField(0), "ORDERS.orderkey");
-    orders.custkey = safe_stoi(rec.getField(1), "ORDERS.custkey");
-    orders.orderstatus = rec.getField(2);
-    orders.totalprice = safe_stof(rec.getField(3), "ORDERS.totalprice");
-    orders.orderdate = rec.getField(4);
-    orders.orderpriority = rec.getField(5);
-    orders.clerk = rec.getField(6);
-    orders.shippriority = safe_stoi(rec.getField(7), "ORDERS.shippriority");
-    orders.comment = rec.getField(8);
+    orders.orderkey = rec.getInt(0);
+    orders.custkey = rec.getInt(1);
+    orders.orderstatus = rec.getString(2);
+    orders.totalprice = rec.getDecimal(3);
+    orders.orderdate = rec.getString(4);
+    orders.orderpriority = rec.getString(5);
+    orders.clerk = rec.getString(6);
+    orders.shippriority = rec.getInt(7);
+    orders.comment = rec.getString(8);
     return orders;
 }
 
@@ -333,24 +352,25 @@ OrdersRecord OrdersRecord::fromCSV(const std::string& line) {
 
 // LineItemRecord 구현
 Record LineItemRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(orderkey));
-    fields.push_back(std::to_string(partkey));
-    fields.push_back(std::to_string(suppkey));
-    fields.push_back(std::to_string(linenumber));
-    fields.push_back(std::to_string(quantity));
-    fields.push_back(std::to_string(extendedprice));
-    fields.push_back(std::to_string(discount));
-    fields.push_back(std::to_string(tax));
-    fields.push_back(returnflag);
-    fields.push_back(linestatus);
-    fields.push_back(shipdate);
-    fields.push_back(commitdate);
-    fields.push_back(receiptdate);
-    fields.push_back(shipinstruct);
-    fields.push_back(shipmode);
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("LINEITEM");
+    RecordBuilder builder(schema);
+    builder.setInt(0, orderkey);
+    builder.setInt(1, partkey);
+    builder.setInt(2, suppkey);
+    builder.setInt(3, linenumber);
+    builder.setDecimal(4, quantity);
+    builder.setDecimal(5, extendedprice);
+    builder.setDecimal(6, discount);
+    builder.setDecimal(7, tax);
+    builder.setString(8, returnflag);
+    builder.setString(9, linestatus);
+    builder.setString(10, shipdate);
+    builder.setString(11, commitdate);
+    builder.setString(12, receiptdate);
+    builder.setString(13, shipinstruct);
+    builder.setString(14, shipmode);
+    builder.setString(15, comment);
+    return builder.build();
 }
 
 LineItemRecord LineItemRecord::fromRecord(const Record& rec) {
@@ -358,22 +378,22 @@ LineItemRecord LineItemRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 16) {
         throw std::runtime_error("Invalid LINEITEM record: expected 16 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    lineitem.orderkey = safe_stoi(rec.getField(0), "LINEITEM.orderkey");
-    lineitem.partkey = safe_stoi(rec.getField(1), "LINEITEM.partkey");
-    lineitem.suppkey = safe_stoi(rec.getField(2), "LINEITEM.suppkey");
-    lineitem.linenumber = safe_stoi(rec.getField(3), "LINEITEM.linenumber");
-    lineitem.quantity = safe_stof(rec.getField(4), "LINEITEM.quantity");
-    lineitem.extendedprice = safe_stof(rec.getField(5), "LINEITEM.extendedprice");
-    lineitem.discount = safe_stof(rec.getField(6), "LINEITEM.discount");
-    lineitem.tax = safe_stof(rec.getField(7), "LINEITEM.tax");
-    lineitem.returnflag = rec.getField(8);
-    lineitem.linestatus = rec.getField(9);
-    lineitem.shipdate = rec.getField(10);
-    lineitem.commitdate = rec.getField(11);
-    lineitem.receiptdate = rec.getField(12);
-    lineitem.shipinstruct = rec.getField(13);
-    lineitem.shipmode = rec.getField(14);
-    lineitem.comment = rec.getField(15);
+    lineitem.orderkey = rec.getInt(0);
+    lineitem.partkey = rec.getInt(1);
+    lineitem.suppkey = rec.getInt(2);
+    lineitem.linenumber = rec.getInt(3);
+    lineitem.quantity = rec.getDecimal(4);
+    lineitem.extendedprice = rec.getDecimal(5);
+    lineitem.discount = rec.getDecimal(6);
+    lineitem.tax = rec.getDecimal(7);
+    lineitem.returnflag = rec.getString(8);
+    lineitem.linestatus = rec.getString(9);
+    lineitem.shipdate = rec.getString(10);
+    lineitem.commitdate = rec.getString(11);
+    lineitem.receiptdate = rec.getString(12);
+    lineitem.shipinstruct = rec.getString(13);
+    lineitem.shipmode = rec.getString(14);
+    lineitem.comment = rec.getString(15);
     return lineitem;
 }
 
@@ -420,12 +440,13 @@ LineItemRecord LineItemRecord::fromCSV(const std::string& line) {
 
 // NationRecord 구현
 Record NationRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(nationkey));
-    fields.push_back(name);
-    fields.push_back(std::to_string(regionkey));
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("NATION");
+    RecordBuilder builder(schema);
+    builder.setInt(0, nationkey);
+    builder.setString(1, name);
+    builder.setInt(2, regionkey);
+    builder.setString(3, comment);
+    return builder.build();
 }
 
 NationRecord NationRecord::fromRecord(const Record& rec) {
@@ -433,10 +454,10 @@ NationRecord NationRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 4) {
         throw std::runtime_error("Invalid NATION record: expected 4 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    nation.nationkey = safe_stoi(rec.getField(0), "NATION.nationkey");
-    nation.name = rec.getField(1);
-    nation.regionkey = safe_stoi(rec.getField(2), "NATION.regionkey");
-    nation.comment = rec.getField(3);
+    nation.nationkey = rec.getInt(0);
+    nation.name = rec.getString(1);
+    nation.regionkey = rec.getInt(2);
+    nation.comment = rec.getString(3);
     return nation;
 }
 
@@ -460,11 +481,12 @@ NationRecord NationRecord::fromCSV(const std::string& line) {
 
 // RegionRecord 구현
 Record RegionRecord::toRecord() const {
-    std::vector<std::string> fields;
-    fields.push_back(std::to_string(regionkey));
-    fields.push_back(name);
-    fields.push_back(comment);
-    return Record(fields);
+    static const Schema* schema = &Schema::forTable("REGION");
+    RecordBuilder builder(schema);
+    builder.setInt(0, regionkey);
+    builder.setString(1, name);
+    builder.setString(2, comment);
+    return builder.build();
 }
 
 RegionRecord RegionRecord::fromRecord(const Record& rec) {
@@ -472,9 +494,9 @@ RegionRecord RegionRecord::fromRecord(const Record& rec) {
     if (rec.getFieldCount() < 3) {
         throw std::runtime_error("Invalid REGION record: expected 3 fields, got " + std::to_string(rec.getFieldCount()));
     }
-    region.regionkey = safe_stoi(rec.getField(0), "REGION.regionkey");
-    region.name = rec.getField(1);
-    region.comment = rec.getField(2);
+    region.regionkey = rec.getInt(0);
+    region.name = rec.getString(1);
+    region.comment = rec.getString(2);
     return region;
 }
 
@@ -494,179 +516,610 @@ RegionRecord RegionRecord::fromCSV(const std::string& line) {
 
 // JoinResultRecord 구현
 Record JoinResultRecord::toRecord() const {
-    std::vector<std::string> fields;
+    static const Schema schema = Schema::concat(Schema::forTable("PART"),
+                                                Schema::forTable("PARTSUPP"));
+    return Record::concat(&schema, part.toRecord(), partsupp.toRecord());
+}
 
-    // PART 필드
-    fields.push_back(std::to_string(part.partkey));
-    fields.push_back(part.name);
-    fields.push_back(part.mfgr);
-    fields.push_back(part.brand);
-    fields.push_back(part.type);
-    fields.push_back(std::to_string(part.size));
-    fields.push_back(part.container);
-    fields.push_back(std::to_string(part.retailprice));
-    fields.push_back(part.comment);
+// TableReader 구현
 
-    // PARTSUPP 필드
-    fields.push_back(std::to_string(partsupp.partkey));
-    fields.push_back(std::to_string(partsupp.suppkey));
-    fields.push_back(std::to_string(partsupp.availqty));
-    fields.push_back(std::to_string(partsupp.supplycost));
-    fields.push_back(partsupp.comment);
+static const int PENDING = INT_MIN;
 
-    return Record(fields);
+// fd 기반 백엔드용 파일 열기 (O_DIRECT 요청 시 함께 지정)
+static int openBlockFile(const std::string& filename, int flags, bool direct) {
+    if (direct) {
+        flags |= O_DIRECT;
+    }
+    int fd = ::open(filename.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename + " (" +
+                                 std::strerror(errno) + ")");
+    }
+    return fd;
 }
 
-// TableReader 구현
 TableReader::TableReader(const std::string& fname, size_t blk_size, Statistics* st)
-    : filename(fname), block_size(blk_size), stats(st) {
-    file.open(filename, std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
+    : TableReader(fname, blk_size, st, getDefaultIoOptions()) {}
+
+TableReader::TableReader(const std::string& fname, size_t blk_size, Statistics* st,
+                         const IoOptions& options)
+    : filename(fname), fd(-1), io(resolveIoOptions(options, blk_size)),
+      block_size(blk_size), block_count(0), next_page(0), stats(st),
+      submitted_end(0), inflight(0) {
+
+    // 메타데이터가 있으면 기록할 때의 블록 크기와 같아야 함
+    TableMetadata::checkBlockSize(filename, block_size);
+
+    std::streamoff file_size = 0;
+    if (io.backend == IoBackend::STREAM) {
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        file.seekg(0, std::ios::end);
+        file_size = file.tellg();
+        file.seekg(0, std::ios::beg);
+    } else {
+        fd = openBlockFile(filename, O_RDONLY, io.direct);
+        struct stat st_buf;
+        if (fstat(fd, &st_buf) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat file: " + filename);
+        }
+        file_size = static_cast<std::streamoff>(st_buf.st_size);
+    }
+
+    // 파일 크기는 항상 페이지 크기의 배수여야 함
+    if (file_size % static_cast<std::streamoff>(block_size) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("File size of " + filename + " (" + std::to_string(file_size) +
+                                 " bytes) is not a multiple of block size " +
+                                 std::to_string(block_size));
+    }
+    block_count = static_cast<size_t>(file_size) / block_size;
+
+    if (io.backend == IoBackend::URING) {
+        ring.reset(new IoUring(static_cast<unsigned>(io.queue_depth)));
+        for (size_t i = 0; i < io.queue_depth; ++i) {
+            window.emplace_back(block_size);
+        }
+        window_result.assign(io.queue_depth, 0);
     }
 }
 
 TableReader::~TableReader() {
+    // 커널이 창 버퍼에 쓰는 중일 수 있으므로 해제 전에 완료를 기다림
+    if (ring) {
+        try {
+            drainWindow();
+        } catch (const std::exception&) {
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
     if (file.is_open()) {
         file.close();
     }
 }
 
+void TableReader::fetchPage(Block* block, size_t page_no) {
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while reading " + filename);
+    }
+
+    // 페이지 전체를 그대로 덮어쓰므로 clear() 불필요
+    if (io.backend == IoBackend::STREAM) {
+        file.read(block->getData(), block_size);
+        if (static_cast<size_t>(file.gcount()) != block_size) {
+            throw std::runtime_error("Short read at page " + std::to_string(page_no) +
+                                     " of " + filename);
+        }
+        return;
+    }
+
+    size_t done = 0;
+    while (done < block_size) {
+        ssize_t n = pread(fd, block->getData() + done, block_size - done,
+                          static_cast<off_t>(page_no * block_size + done));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            throw std::runtime_error("Short read at page " + std::to_string(page_no) +
+                                     " of " + filename);
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+void TableReader::checkPage(const Block* block, size_t page_no) {
+    if (!block->isValid()) {
+        throw std::runtime_error("Corrupt page " + std::to_string(page_no) + " in " +
+                                 filename + " (wrong --block-size?)");
+    }
+
+    if (stats) {
+        stats->block_reads++;
+    }
+}
+
+bool TableReader::readPage(Block* block, size_t page_no) {
+    fetchPage(block, page_no);
+    checkPage(block, page_no);
+    return true;
+}
+
+void TableReader::fillWindow() {
+    size_t depth = window.size();
+    bool added = false;
+
+    while (submitted_end < block_count && submitted_end < next_page + depth) {
+        // 건너뛸 페이지는 제출하지 않음 (readBlock도 그 슬롯을 보지 않음)
+        if (filter.skip(submitted_end)) {
+            submitted_end++;
+            continue;
+        }
+        size_t slot = submitted_end % depth;
+        ring->prepRead(fd, window[slot].getData(), block_size,
+                       static_cast<off_t>(submitted_end * block_size), submitted_end);
+        window_result[slot] = PENDING;
+        submitted_end++;
+        inflight++;
+        added = true;
+    }
+
+    if (added) {
+        ring->submit(0);
+    }
+}
+
+void TableReader::reapCompletions(bool wait) {
+    if (wait) {
+        ring->submit(1);
+    }
+
+    uint64_t tag;
+    int result;
+    while (ring->popCompletion(tag, result)) {
+        window_result[tag % window.size()] = result;
+        inflight--;
+    }
+}
+
+void TableReader::drainWindow() {
+    while (inflight > 0) {
+        reapCompletions(true);
+    }
+    submitted_end = next_page;
+}
+
+void TableReader::skipFilteredPages() {
+    size_t start = next_page;
+    while (next_page < block_count && filter.skip(next_page)) {
+        next_page++;
+    }
+    if (next_page == start) {
+        return;
+    }
+
+    if (stats) {
+        stats->blocks_skipped += next_page - start;
+    }
+    if (io.backend == IoBackend::STREAM) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(next_page * block_size), std::ios::beg);
+    } else if (submitted_end < next_page) {
+        // 건너뛴 페이지는 제출된 적이 없으므로 창은 next_page부터 이어짐
+        submitted_end = next_page;
+    }
+}
+
+void TableReader::setPageFilter(const PageFilter& page_filter) {
+    // 이미 제출한 읽기는 이전 필터 기준이므로 모두 끝낸 뒤 교체
+    if (ring) {
+        drainWindow();
+    }
+    filter = page_filter;
+}
+
 bool TableReader::readBlock(Block* block) {
-    if (!file.is_open() || file.eof()) {
+    if (!isOpen()) {
+        return false;
+    }
+    skipFilteredPages();
+    if (next_page >= block_count) {
         return false;
     }
 
-    block->clear();
+    if (io.backend != IoBackend::URING) {
+        readPage(block, next_page);
+        next_page++;
+        return true;
+    }
 
-    // 블록 크기만큼 읽기
-    file.read(block->getData(), block->getSize());
-    std::streamsize bytes_read = file.gcount();
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while reading " + filename);
+    }
 
-    if (bytes_read == 0) {
-        return false;
+    // 창을 채우고 이번 페이지의 읽기가 끝날 때까지 대기
+    fillWindow();
+    size_t slot = next_page % window.size();
+    while (window_result[slot] == PENDING) {
+        reapCompletions(true);
     }
 
-    // 실제로 읽은 바이트 수를 used_size로 설정
-    block->setUsedSize(static_cast<size_t>(bytes_read));
+    int result = window_result[slot];
+    if (result < 0) {
+        throw std::runtime_error("Read error at page " + std::to_string(next_page) + " of " +
+                                 filename + ": " + std::strerror(-result));
+    }
+    if (static_cast<size_t>(result) != block_size) {
+        throw std::runtime_error("Short read at page " + std::to_string(next_page) +
+                                 " of " + filename);
+    }
 
-    if (stats) {
-        stats->block_reads++;
+    // 복사 없이 창 버퍼와 호출자 블록을 교환하고, 비운 슬롯에 다음 읽기 제출
+    std::swap(*block, window[slot]);
+    checkPage(block, next_page);
+    next_page++;
+    fillWindow();
+    return true;
+}
+
+bool TableReader::readBlockAt(size_t page_no, Block* block) {
+    if (!isOpen() || page_no >= block_count) {
+        return false;
+    }
+
+    if (io.backend == IoBackend::STREAM) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(page_no * block_size), std::ios::beg);
+    } else if (ring) {
+        // 순차 읽기 창을 비우고 이 페이지부터 다시 시작
+        drainWindow();
     }
+    readPage(block, page_no);
 
+    // 이후 순차 읽기는 다음 페이지부터 이어짐
+    next_page = page_no + 1;
+    submitted_end = next_page;
     return true;
 }
 
+Record TableReader::readRecord(const RecordId& rid, const Schema* schema, Block* scratch) {
+    if (!readBlockAt(rid.page_no, scratch)) {
+        throw std::runtime_error("Page " + std::to_string(rid.page_no) + " out of range in " +
+                                 filename);
+    }
+
+    RecordReader reader(scratch, schema);
+    return reader.readAt(rid.slot_no).materialize();
+}
+
 void TableReader::reset() {
-    file.clear();
-    file.seekg(0, std::ios::beg);
+    if (io.backend == IoBackend::STREAM) {
+        file.clear();
+        file.seekg(0, std::ios::beg);
+    } else if (ring) {
+        drainWindow();
+    }
+    next_page = 0;
+    submitted_end = 0;
 }
 
 // TableWriter 구현
 TableWriter::TableWriter(const std::string& fname, Statistics* st)
-    : filename(fname), stats(st) {
-    file.open(filename, std::ios::binary | std::ios::trunc);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
+    : TableWriter(fname, st, getDefaultIoOptions()) {}
+
+TableWriter::TableWriter(const std::string& fname, Statistics* st, const IoOptions& options)
+    : filename(fname), fd(-1), io(resolveIoOptions(options, DEFAULT_BLOCK_SIZE)),
+      write_offset(0), stats(st), inflight(0) {
+
+    if (io.backend == IoBackend::STREAM) {
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        return;
+    }
+
+    fd = openBlockFile(filename, O_WRONLY | O_CREAT | O_TRUNC, io.direct);
+    if (io.backend == IoBackend::URING) {
+        ring.reset(new IoUring(static_cast<unsigned>(io.queue_depth)));
     }
 }
 
 TableWriter::~TableWriter() {
-    if (file.is_open()) {
-        file.close();
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+void TableWriter::reapCompletions(bool wait) {
+    if (wait) {
+        ring->submit(1);
+    }
+
+    uint64_t tag;
+    int result;
+    while (ring->popCompletion(tag, result)) {
+        inflight--;
+        size_t slot = static_cast<size_t>(tag);
+        free_slots.push_back(slot);
+
+        if (result < 0) {
+            throw std::runtime_error("Write error on " + filename + ": " +
+                                     std::strerror(-result));
+        }
+        if (static_cast<size_t>(result) != window[slot].getSize()) {
+            throw std::runtime_error("Short write on " + filename);
+        }
     }
 }
 
 bool TableWriter::writeBlock(const Block* block) {
-    if (!file.is_open() || block->isEmpty()) {
+    if (!isOpen() || block->isEmpty()) {
         return false;
     }
 
-    // 사용된 크기만큼만 쓰기
-    file.write(block->getData(), block->getUsedSize());
+    // 페이지 경계를 맞추기 위해 항상 블록 전체(block_size 바이트)를 씀
+    // (재사용 버퍼의 이전 내용이 파일에 남지 않도록 빈 공간은 0으로)
+    block->zeroFreeSpace();
+    size_t size = block->getSize();
+    bool ok = true;
+
+    if (io.backend == IoBackend::STREAM) {
+        file.write(block->getData(), size);
+        ok = file.good();
+    } else if (io.backend == IoBackend::PREAD) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = pwrite(fd, block->getData() + done, size - done,
+                               static_cast<off_t>(write_offset + done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                throw std::runtime_error("Write error on " + filename + ": " +
+                                         std::strerror(errno));
+            }
+            done += static_cast<size_t>(n);
+        }
+    } else {
+        // 창 버퍼는 첫 쓰기 때 블록 크기로 할당
+        if (window.empty()) {
+            for (size_t i = 0; i < io.queue_depth; ++i) {
+                window.emplace_back(size);
+                free_slots.push_back(i);
+            }
+        }
+        if (size != window[0].getSize()) {
+            throw std::runtime_error("Block size mismatch while writing " + filename);
+        }
 
+        while (free_slots.empty()) {
+            reapCompletions(true);
+        }
+        size_t slot = free_slots.back();
+        free_slots.pop_back();
+
+        std::memcpy(window[slot].getData(), block->getData(), size);
+        ring->prepWrite(fd, window[slot].getData(), size,
+                        static_cast<off_t>(write_offset), slot);
+        ring->submit(0);
+        inflight++;
+        reapCompletions(false);
+    }
+
+    write_offset += size;
     if (stats) {
         stats->block_writes++;
     }
 
-    return file.good();
+    return ok;
 }
 
+void TableWriter::close() {
+    if (ring) {
+        while (inflight > 0) {
+            reapCompletions(true);
+        }
+        ring.reset();
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+// ============================================================================
+// TBL 변환 (병렬 파싱 + 순서 보존 기록)
+// ============================================================================
+
+// 입력 청크 하나와 그 파싱 결과
+struct TBLChunk {
+    size_t seq;                        // 입력 순서 번호
+    std::string text;                  // 줄 경계에서 끊은 입력 텍스트
+    TBLParser::Output parsed;          // 인코딩된 레코드와 파싱 오류 메시지
+};
+
+// 입력 파일을 약 chunk_size 바이트씩, 항상 줄 경계에서 잘라 읽음
+class TBLChunkReader {
+private:
+    std::ifstream input;
+    std::string carry;     // 이전 읽기에서 남은 미완성 줄
+    size_t chunk_size;
+
+public:
+    TBLChunkReader(const std::string& file, size_t size)
+        : input(file, std::ios::binary), chunk_size(size) {
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open TBL file: " + file);
+        }
+    }
+
+    // 다음 청크를 out에 채움 (입력 끝이면 false)
+    bool next(std::string& out) {
+        out.swap(carry);
+        carry.clear();
+
+        while (input) {
+            size_t old_size = out.size();
+            out.resize(old_size + chunk_size);
+            input.read(&out[old_size], static_cast<std::streamsize>(chunk_size));
+            out.resize(old_size + static_cast<size_t>(input.gcount()));
+
+            // 마지막 줄바꿈 뒤의 미완성 줄은 다음 청크로 넘김
+            size_t last_newline = out.rfind('\n');
+            if (last_newline != std::string::npos && last_newline >= old_size) {
+                carry.assign(out, last_newline + 1, std::string::npos);
+                out.resize(last_newline + 1);
+                return true;
+            }
+            // 청크보다 긴 줄이면 줄바꿈이 나올 때까지 계속 읽음
+        }
+
+        // 파일 끝: 줄바꿈 없이 끝나는 마지막 줄 포함
+        return !out.empty();
+    }
+};
+
 // TBL 파일을 블록 파일로 변환
+//
+// 입력을 줄 경계에서 TBL_CHUNK_SIZE 단위 청크로 나누고, 작업자 스레드가 청크를
+// TBLParser로 파싱·인코딩한 뒤 기록 담당이 레코드를 블록에 채운다. 기록 담당은 파싱을
+// 마친 스레드 중 하나가 차례로 맡으며, 블록 기록과 메타데이터 갱신은 청크 분배 mutex
+// 밖에서 하므로 다른 스레드는 기다리지 않고 다음 청크를 가져간다. preserve_order이면
+// 청크를 입력 순서대로 블록에 채우므로 출력은 스레드 수와 무관하게 단일 스레드 변환과
+// 바이트 단위로 같다. 아니면 파싱이 끝난 순서대로 채운다 (레코드 집합은 동일).
+static const size_t TBL_CHUNK_SIZE = 4 * 1024 * 1024;
+
 void convertTBLToBlocks(const std::string& tbl_file,
                         const std::string& block_file,
                         const std::string& table_type,
-                        size_t block_size) {
-    std::ifstream input(tbl_file);
-    if (!input.is_open()) {
-        throw std::runtime_error("Failed to open TBL file: " + tbl_file);
-    }
+                        size_t block_size,
+                        size_t num_threads,
+                        bool preserve_order) {
+    TBLParser::legacyParserFor(table_type);   // 알 수 없는 타입이면 여기서 예외
+    TBLChunkReader input(tbl_file, TBL_CHUNK_SIZE);
+
+    // 이전 변환의 메타데이터/존 맵은 변환이 끝나기 전까지 유효하지 않음
+    std::remove(TableMetadata::pathFor(block_file).c_str());
+    std::remove(ZoneMap::pathFor(block_file).c_str());
 
     TableWriter writer(block_file, nullptr);
     Block block(block_size);
-    RecordWriter rec_writer(&block);
-
-    std::string line;
-    int record_count = 0;
-
-    while (std::getline(input, line)) {
-        if (line.empty()) continue;
-
-        try {
-            Record record;
-
-            if (table_type == "PART") {
-                PartRecord part = PartRecord::fromCSV(line);
-                record = part.toRecord();
-            } else if (table_type == "PARTSUPP") {
-                PartSuppRecord partsupp = PartSuppRecord::fromCSV(line);
-                record = partsupp.toRecord();
-            } else if (table_type == "SUPPLIER") {
-                SupplierRecord supplier = SupplierRecord::fromCSV(line);
-                record = supplier.toRecord();
-            } else if (table_type == "CUSTOMER") {
-                CustomerRecord customer = CustomerRecord::fromCSV(line);
-                record = customer.toRecord();
-            } else if (table_type == "ORDERS") {
-                OrdersRecord orders = OrdersRecord::fromCSV(line);
-                record = orders.toRecord();
-            } else if (table_type == "LINEITEM") {
-                LineItemRecord lineitem = LineItemRecord::fromCSV(line);
-                record = lineitem.toRecord();
-            } else if (table_type == "NATION") {
-                NationRecord nation = NationRecord::fromCSV(line);
-                record = nation.toRecord();
-            } else if (table_type == "REGION") {
-                RegionRecord region = RegionRecord::fromCSV(line);
-                record = region.toRecord();
-            } else {
-                throw std::runtime_error("Unknown table type: " + table_type);
-            }
+    TableMetadata meta;
+    meta.reset(table_type, block_size);
+    ZoneMap zones(meta.getSchema());
+
+    size_t thread_count = num_threads > 0 ? num_threads : 1;
+    size_t max_pending = 2 * thread_count;   // 순서 대기 포함 동시에 메모리에 있는 청크 수
+
+    std::mutex mutex;
+    std::condition_variable chunk_written;
+    size_t next_read_seq = 0;
+    size_t next_write_seq = 0;
+    size_t next_ready_seq = 0;
+    std::map<size_t, TBLChunk> finished;      // 앞 청크를 기다리는 파싱 완료 청크
+    std::deque<TBLChunk> ready;               // 블록에 채울 차례가 된 청크 (기록 순서)
+    bool emitting = false;                    // 한 스레드가 ready를 기록하는 중
+    bool failed = false;
+    size_t record_count = 0;
+
+    // 청크의 레코드를 블록에 채움 (emitting을 맡은 스레드만, mutex 없이 호출)
+    auto emit = [&](const TBLChunk& chunk) {
+        for (const std::string& error : chunk.parsed.errors) {
+            std::cerr << error << std::endl;
+        }
 
-            // 블록에 레코드 쓰기
-            if (!rec_writer.writeRecord(record)) {
+        const char* data = chunk.parsed.encoded.data();
+        for (uint32_t size : chunk.parsed.sizes) {
+            if (!block.append(data, size)) {
                 // 블록이 가득 차면 디스크에 쓰고 새 블록 시작
+                meta.addBlock(block);
+                zones.addBlock(block);
                 writer.writeBlock(&block);
                 block.clear();
 
-                // 새 블록에 레코드 쓰기
-                if (!rec_writer.writeRecord(record)) {
+                if (!block.append(data, size)) {
                     throw std::runtime_error("Record too large for block");
                 }
             }
+            data += size;
+        }
+        record_count += chunk.parsed.sizes.size();
+    };
 
-            record_count++;
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing line: " << line << "\nError: " << e.what() << std::endl;
+    runParallel(thread_count, [&](size_t) {
+        TBLParser parser(table_type);
+        try {
+            while (true) {
+                TBLChunk chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    // 순서 대기 청크가 쌓이지 않도록 읽기를 제한
+                    chunk_written.wait(lock, [&]() {
+                        return failed || next_read_seq - next_write_seq < max_pending;
+                    });
+                    if (failed || !input.next(chunk.text)) break;
+                    chunk.seq = next_read_seq++;
+                }
+
+                parser.parseChunk(chunk.text.data(), chunk.text.size(), chunk.parsed);
+                std::string().swap(chunk.text);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!preserve_order) {
+                    ready.push_back(std::move(chunk));
+                } else {
+                    finished.emplace(chunk.seq, std::move(chunk));
+                    while (!finished.empty() && finished.begin()->first == next_ready_seq) {
+                        ready.push_back(std::move(finished.begin()->second));
+                        finished.erase(finished.begin());
+                        next_ready_seq++;
+                    }
+                }
+
+                // 다른 스레드가 기록 중이면 그 스레드가 ready를 마저 비움
+                if (emitting) continue;
+                emitting = true;
+                while (!ready.empty() && !failed) {
+                    TBLChunk next = std::move(ready.front());
+                    ready.pop_front();
+                    lock.unlock();
+                    emit(next);
+                    lock.lock();
+                    next_write_seq++;
+                    chunk_written.notify_all();
+                }
+                emitting = false;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            chunk_written.notify_all();
+            throw;
         }
-    }
+    });
 
     // 마지막 블록 쓰기
     if (!block.isEmpty()) {
+        meta.addBlock(block);
+        zones.addBlock(block);
         writer.writeBlock(&block);
     }
+    writer.close();
+    meta.save(block_file);
+    zones.save(block_file, block_size);
 
-    input.close();
     std::cout << "Converted " << record_count << " records from " << tbl_file
-              << " to " << block_file << std::endl;
+              << " to " << block_file;
+    if (thread_count > 1) {
+        std::cout << " (" << thread_count << " threads, "
+                  << (preserve_order ? "input order" : "unordered") << ")";
+    }
+    std::cout << std::endl;
 }
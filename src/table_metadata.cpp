@@ -0,0 +1,412 @@
+#include "table_metadata.h"
+#include "record.h"
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+static const int METADATA_VERSION = 1;
+
+static const char* fieldTypeName(FieldType type) {
+    switch (type) {
+        case FieldType::INT: return "INT";
+        case FieldType::DECIMAL: return "DECIMAL";
+        default: return "STRING";
+    }
+}
+
+// 파일 크기와 수정 시각 (ns), 없으면 false
+static bool statFile(const std::string& path, uint64_t& size, int64_t& mtime_ns) {
+    struct stat st_buf;
+    if (stat(path.c_str(), &st_buf) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(st_buf.st_size);
+    mtime_ns = static_cast<int64_t>(st_buf.st_mtim.tv_sec) * 1000000000LL +
+               st_buf.st_mtim.tv_nsec;
+    return true;
+}
+
+// 값 하나를 텍스트로 (DECIMAL은 float로 되돌렸을 때 같은 값이 되는 9자리)
+static std::string formatValue(FieldType type, double v) {
+    char buf[32];
+    if (type == FieldType::INT) {
+        std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(v));
+    } else {
+        std::snprintf(buf, sizeof(buf), "%.9g", v);
+    }
+    return buf;
+}
+
+void TableMetadata::reset(const std::string& type, size_t blk_size) {
+    const Schema& schema = Schema::forTable(type);
+    table_type = type;
+    block_size = blk_size;
+    data_size = 0;
+    record_count = 0;
+    record_bytes = 0;
+    block_count = 0;
+    ranges.assign(schema.getColumnCount(), ColumnRange());
+}
+
+void TableMetadata::addBlock(const Block& block) {
+    const Schema* schema = &getSchema();
+    size_t columns = schema->getColumnCount();
+
+    RecordReader reader(&block, schema);
+    while (reader.hasNext()) {
+        RecordView record = reader.readNext();
+        for (size_t i = 0; i < columns; ++i) {
+            FieldType type = schema->getColumn(i).type;
+            if (type == FieldType::INT) {
+                ranges[i].add(record.getInt(i));
+            } else if (type == FieldType::DECIMAL) {
+                ranges[i].add(record.getDecimal(i));
+            }
+        }
+        record_count++;
+        record_bytes += record.getSize();
+    }
+    block_count++;
+}
+
+void TableMetadata::save(const std::string& data_file) {
+    int64_t mtime_ns;
+    if (!statFile(data_file, data_size, mtime_ns)) {
+        throw std::runtime_error("Failed to stat file: " + data_file);
+    }
+
+    const Schema& schema = getSchema();
+    std::ostringstream out;
+    out << "# dbsys table metadata\n";
+    out << "version " << METADATA_VERSION << "\n";
+    out << "table_type " << table_type << "\n";
+    out << "block_size " << block_size << "\n";
+    out << "data_size " << data_size << "\n";
+    out << "record_count " << record_count << "\n";
+    out << "record_bytes " << record_bytes << "\n";
+    out << "block_count " << block_count << "\n";
+    for (size_t i = 0; i < schema.getColumnCount(); ++i) {
+        const Column& col = schema.getColumn(i);
+        out << "column " << col.name << " " << fieldTypeName(col.type);
+        if (col.type != FieldType::STRING) {
+            if (ranges[i].valid) {
+                out << " " << formatValue(col.type, ranges[i].min)
+                    << " " << formatValue(col.type, ranges[i].max);
+            } else {
+                out << " - -";
+            }
+        }
+        out << "\n";
+    }
+
+    // 읽는 쪽이 반쯤 쓰인 파일을 보지 않도록 임시 파일에 쓰고 이름 변경
+    std::string path = pathFor(data_file);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + tmp_path);
+        }
+        file << out.str();
+        if (!file.good()) {
+            throw std::runtime_error("Write error on " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Failed to rename " + tmp_path + ": " + std::strerror(errno));
+    }
+}
+
+bool TableMetadata::load(const std::string& data_file, TableMetadata& meta) {
+    std::string path = pathFor(data_file);
+    uint64_t data_size, meta_size;
+    int64_t data_mtime, meta_mtime;
+    if (!statFile(path, meta_size, meta_mtime) || !statFile(data_file, data_size, data_mtime)) {
+        return false;
+    }
+    // 메타데이터를 쓴 뒤 .dat가 다시 기록됨
+    if (data_mtime > meta_mtime) {
+        return false;
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto corrupt = [&](const std::string& what) {
+        return std::runtime_error("Corrupt metadata file " + path + ": " + what);
+    };
+
+    TableMetadata loaded;
+    int version = 0;
+    std::vector<std::string> column_lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "version") {
+            fields >> version;
+        } else if (key == "table_type") {
+            fields >> loaded.table_type;
+        } else if (key == "block_size") {
+            fields >> loaded.block_size;
+        } else if (key == "data_size") {
+            fields >> loaded.data_size;
+        } else if (key == "record_count") {
+            fields >> loaded.record_count;
+        } else if (key == "record_bytes") {
+            fields >> loaded.record_bytes;
+        } else if (key == "block_count") {
+            fields >> loaded.block_count;
+        } else if (key == "column") {
+            column_lines.push_back(line);
+            continue;
+        } else {
+            throw corrupt("unknown key '" + key + "'");
+        }
+        if (fields.fail()) {
+            throw corrupt("bad value for " + key);
+        }
+    }
+
+    if (version != METADATA_VERSION) {
+        throw corrupt("unsupported version " + std::to_string(version));
+    }
+    if (loaded.block_size == 0) {
+        throw corrupt("missing block_size");
+    }
+    if (loaded.data_size != data_size) {
+        return false;
+    }
+    if (loaded.block_count * loaded.block_size != loaded.data_size) {
+        throw corrupt("block_count does not match data_size");
+    }
+
+    // 스키마가 현재 빌드의 테이블 정의와 같은지 확인
+    const Schema* schema;
+    try {
+        schema = &Schema::forTable(loaded.table_type);
+    } catch (const std::exception&) {
+        throw corrupt("unknown table type '" + loaded.table_type + "'");
+    }
+    if (column_lines.size() != schema->getColumnCount()) {
+        throw corrupt("column count does not match " + loaded.table_type + " schema");
+    }
+
+    loaded.ranges.assign(schema->getColumnCount(), ColumnRange());
+    for (size_t i = 0; i < column_lines.size(); ++i) {
+        const Column& col = schema->getColumn(i);
+        std::istringstream fields(column_lines[i]);
+        std::string key, name, type, min_text, max_text;
+        fields >> key >> name >> type;
+        if (name != col.name || type != fieldTypeName(col.type)) {
+            throw corrupt("column " + std::to_string(i) + " is " + name + " " + type +
+                          ", expected " + col.name + " " + fieldTypeName(col.type));
+        }
+        if (col.type == FieldType::STRING) continue;
+
+        fields >> min_text >> max_text;
+        if (fields.fail()) {
+            throw corrupt("missing range for column " + col.name);
+        }
+        if (min_text == "-") continue;
+
+        ColumnRange& range = loaded.ranges[i];
+        range.valid = true;
+        range.min = std::strtod(min_text.c_str(), nullptr);
+        range.max = std::strtod(max_text.c_str(), nullptr);
+        if (col.type == FieldType::DECIMAL) {
+            range.min = static_cast<decimal_t>(range.min);
+            range.max = static_cast<decimal_t>(range.max);
+        }
+    }
+
+    meta = loaded;
+    return true;
+}
+
+void TableMetadata::checkBlockSize(const std::string& data_file, size_t block_size) {
+    TableMetadata meta;
+    if (load(data_file, meta) && meta.block_size != block_size) {
+        throw std::runtime_error(data_file + " was written with block size " +
+                                 std::to_string(meta.block_size) + ", not " +
+                                 std::to_string(block_size) + " (use --block-size " +
+                                 std::to_string(meta.block_size) + ")");
+    }
+}
+
+// ============================================================================
+// ZoneMap 구현
+// ============================================================================
+
+static const char ZONE_MAP_MAGIC[8] = {'D', 'B', 'S', 'Y', 'S', 'Z', 'M', '1'};
+
+static void appendLE32(std::string& out, uint32_t v) {
+    char buf[4];
+    storeLE32(buf, v);
+    out.append(buf, sizeof(buf));
+}
+
+static void appendLE64(std::string& out, uint64_t v) {
+    appendLE32(out, static_cast<uint32_t>(v));
+    appendLE32(out, static_cast<uint32_t>(v >> 32));
+}
+
+static uint64_t loadLE64(const char* p) {
+    return loadLE32(p) | (static_cast<uint64_t>(loadLE32(p + 4)) << 32);
+}
+
+ZoneMap::ZoneMap(const Schema& s) : schema(&s), page_count(0) {
+    static const std::string KEY_SUFFIX = "key";
+    for (size_t i = 0; i < schema->getColumnCount(); ++i) {
+        const Column& col = schema->getColumn(i);
+        if (col.type == FieldType::INT && col.name.size() >= KEY_SUFFIX.size() &&
+            col.name.compare(col.name.size() - KEY_SUFFIX.size(), KEY_SUFFIX.size(),
+                             KEY_SUFFIX) == 0) {
+            columns.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void ZoneMap::addBlock(const Block& block) {
+    // 빈 페이지는 min > max라 어떤 범위와도 겹치지 않음
+    size_t base = bounds.size();
+    for (size_t k = 0; k < columns.size(); ++k) {
+        bounds.push_back(INT32_MAX);
+        bounds.push_back(INT32_MIN);
+    }
+
+    RecordReader reader(&block, schema);
+    while (reader.hasNext()) {
+        RecordView record = reader.readNext();
+        for (size_t k = 0; k < columns.size(); ++k) {
+            int_t v = record.getInt(columns[k]);
+            int_t* range = &bounds[base + 2 * k];
+            if (v < range[0]) range[0] = v;
+            if (v > range[1]) range[1] = v;
+        }
+    }
+    page_count++;
+}
+
+int ZoneMap::findSlot(size_t column) const {
+    for (size_t k = 0; k < columns.size(); ++k) {
+        if (columns[k] == column) {
+            return static_cast<int>(k);
+        }
+    }
+    return -1;
+}
+
+void ZoneMap::save(const std::string& data_file, size_t block_size) const {
+    uint64_t data_size;
+    int64_t mtime_ns;
+    if (!statFile(data_file, data_size, mtime_ns)) {
+        throw std::runtime_error("Failed to stat file: " + data_file);
+    }
+
+    std::string out(ZONE_MAP_MAGIC, sizeof(ZONE_MAP_MAGIC));
+    out.reserve(out.size() + 32 + 4 * columns.size() + 4 * bounds.size());
+    appendLE32(out, static_cast<uint32_t>(block_size));
+    appendLE32(out, static_cast<uint32_t>(columns.size()));
+    appendLE64(out, data_size);
+    appendLE64(out, page_count);
+    for (uint32_t column : columns) {
+        appendLE32(out, column);
+    }
+    for (int_t v : bounds) {
+        appendLE32(out, static_cast<uint32_t>(v));
+    }
+
+    std::string path = pathFor(data_file);
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + tmp_path);
+        }
+        file.write(out.data(), static_cast<std::streamsize>(out.size()));
+        if (!file.good()) {
+            throw std::runtime_error("Write error on " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Failed to rename " + tmp_path + ": " + std::strerror(errno));
+    }
+}
+
+std::shared_ptr<const ZoneMap> ZoneMap::load(const std::string& data_file, size_t block_size) {
+    std::string path = pathFor(data_file);
+    uint64_t data_size, zones_size;
+    int64_t data_mtime, zones_mtime;
+    if (!statFile(path, zones_size, zones_mtime) || !statFile(data_file, data_size, data_mtime) ||
+        data_mtime > zones_mtime) {
+        return nullptr;
+    }
+
+    // 존 맵은 메타데이터와 같은 테이블 타입일 때만 해석 가능
+    TableMetadata meta;
+    if (!TableMetadata::load(data_file, meta)) {
+        return nullptr;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    std::string in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    auto corrupt = [&](const std::string& what) {
+        return std::runtime_error("Corrupt zone map file " + path + ": " + what);
+    };
+
+    const size_t header_size = sizeof(ZONE_MAP_MAGIC) + 24;
+    if (in.size() < header_size ||
+        std::memcmp(in.data(), ZONE_MAP_MAGIC, sizeof(ZONE_MAP_MAGIC)) != 0) {
+        throw corrupt("bad header");
+    }
+    const char* p = in.data() + sizeof(ZONE_MAP_MAGIC);
+    uint32_t stored_block_size = loadLE32(p);
+    uint32_t column_count = loadLE32(p + 4);
+    uint64_t stored_data_size = loadLE64(p + 8);
+    uint64_t pages = loadLE64(p + 16);
+    p += 24;
+
+    if (stored_block_size != block_size || stored_data_size != data_size) {
+        return nullptr;
+    }
+    if (pages != meta.block_count) {
+        throw corrupt("page count does not match data file");
+    }
+
+    std::shared_ptr<ZoneMap> zones = std::make_shared<ZoneMap>(meta.getSchema());
+    if (column_count != zones->columns.size() ||
+        in.size() != header_size + 4 * column_count + 8 * column_count * pages) {
+        throw corrupt("size does not match " + meta.table_type + " key columns");
+    }
+    for (size_t k = 0; k < column_count; ++k, p += 4) {
+        if (loadLE32(p) != zones->columns[k]) {
+            throw corrupt("column list does not match " + meta.table_type + " schema");
+        }
+    }
+
+    zones->bounds.resize(2 * column_count * pages);
+    for (size_t i = 0; i < zones->bounds.size(); ++i, p += 4) {
+        zones->bounds[i] = static_cast<int_t>(loadLE32(p));
+    }
+    zones->page_count = static_cast<size_t>(pages);
+    return zones;
+}
@@ -0,0 +1,321 @@
+#include "tbl_parser.h"
+#include "table.h"
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DBSYS_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// 1단계: 구분자 비트마스크 커널
+// ============================================================================
+
+static uint64_t maskScalar(const char* p) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < 64; ++i) {
+        mask |= static_cast<uint64_t>(p[i] == '|' || p[i] == '\n') << i;
+    }
+    return mask;
+}
+
+#ifdef DBSYS_X86
+
+__attribute__((target("sse2")))
+static uint64_t maskSSE2(const char* p) {
+    const __m128i bar = _mm_set1_epi8('|');
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+
+    // 16바이트씩 4번
+    for (size_t i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, bar), _mm_cmpeq_epi8(v, newline));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hit))) << (16 * i);
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static uint64_t maskAVX2(const char* p) {
+    const __m256i bar = _mm256_set1_epi8('|');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    // 32바이트씩 2번
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    __m256i hit_lo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, bar), _mm256_cmpeq_epi8(lo, newline));
+    __m256i hit_hi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, bar), _mm256_cmpeq_epi8(hi, newline));
+    uint64_t mask_lo = static_cast<uint32_t>(_mm256_movemask_epi8(hit_lo));
+    uint64_t mask_hi = static_cast<uint32_t>(_mm256_movemask_epi8(hit_hi));
+    return mask_lo | (mask_hi << 32);
+}
+
+#endif // DBSYS_X86
+
+// ============================================================================
+// 기존 줄 파서 (fallback / 기준선)
+// ============================================================================
+
+template <typename T>
+static Record parseTBLLine(const std::string& line) {
+    return T::fromCSV(line).toRecord();
+}
+
+TBLParser::LineParser TBLParser::legacyParserFor(const std::string& table_type) {
+    if (table_type == "PART") return &parseTBLLine<PartRecord>;
+    if (table_type == "PARTSUPP") return &parseTBLLine<PartSuppRecord>;
+    if (table_type == "SUPPLIER") return &parseTBLLine<SupplierRecord>;
+    if (table_type == "CUSTOMER") return &parseTBLLine<CustomerRecord>;
+    if (table_type == "ORDERS") return &parseTBLLine<OrdersRecord>;
+    if (table_type == "LINEITEM") return &parseTBLLine<LineItemRecord>;
+    if (table_type == "NATION") return &parseTBLLine<NationRecord>;
+    if (table_type == "REGION") return &parseTBLLine<RegionRecord>;
+    throw std::runtime_error("Unknown table type: " + table_type);
+}
+
+// ============================================================================
+// 숫자 필드 파싱
+// ============================================================================
+
+bool TBLParser::parseInt(const char* begin, const char* end, int_t& value) {
+    const char* p = begin;
+    bool negative = (p < end && *p == '-');
+    if (negative) ++p;
+
+    // int_t 범위 검사를 64비트에서 하도록 최대 10자리
+    size_t digits = static_cast<size_t>(end - p);
+    if (digits == 0 || digits > 10) {
+        return false;
+    }
+
+    int64_t v = 0;
+    for (; p < end; ++p) {
+        unsigned d = static_cast<unsigned char>(*p) - '0';
+        if (d > 9) return false;
+        v = v * 10 + d;
+    }
+    if (negative) v = -v;
+    if (v < INT32_MIN || v > INT32_MAX) {
+        return false;
+    }
+
+    value = static_cast<int_t>(v);
+    return true;
+}
+
+bool TBLParser::parseDecimal(const char* begin, const char* end, decimal_t& value) {
+    static const double POW10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* p = begin;
+    bool negative = (p < end && *p == '-');
+    if (negative) ++p;
+
+    // 가수(정수)와 소수 자릿수로 분해: value = mantissa / 10^frac_digits
+    uint64_t mantissa = 0;
+    size_t digits = 0;
+    size_t frac_digits = 0;
+    bool seen_dot = false;
+    for (; p < end; ++p) {
+        char c = *p;
+        if (c == '.') {
+            if (seen_dot) return false;
+            seen_dot = true;
+            continue;
+        }
+        unsigned d = static_cast<unsigned char>(c) - '0';
+        if (d > 9 || ++digits > 19) return false;
+        mantissa = mantissa * 10 + d;
+        frac_digits += seen_dot;
+    }
+    if (digits == 0) {
+        return false;
+    }
+
+    // 가수와 10^k가 double로 정확하면 나눗셈 한 번이 올바르게 반올림된 double
+    if (mantissa > (1ULL << 53) || frac_digits > 22) {
+        return false;
+    }
+    double d = static_cast<double>(mantissa) / POW10[frac_digits];
+
+    // float 정규 범위 밖은 strtof 처리(비정규/오버플로)에 맡김
+    if (d != 0.0 && (d < FLT_MIN || d > FLT_MAX)) {
+        return false;
+    }
+
+    // double -> float 이중 반올림은 double이 정확히 float 중간점일 때만 strtof와
+    // 다를 수 있음 (중간점은 double로 표현되므로 그 외에는 반올림 방향이 같음)
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    if ((bits & 0x1FFFFFFFULL) == 0x10000000ULL) {
+        return false;
+    }
+
+    float f = static_cast<float>(d);
+    value = negative ? -f : f;
+    return true;
+}
+
+// ============================================================================
+// 2단계: 줄 인코딩
+// ============================================================================
+
+TBLParser::TBLParser(const std::string& table_type, MatchKernel k)
+    : schema(&Schema::forTable(table_type)),
+      legacy(legacyParserFor(table_type)),
+      kernel(k),
+      mask_fn(maskScalar),
+      fast_path(true),
+      fallback_lines(0),
+      supplier_key_col(table_type == "PARTSUPP" ? 1 : SIZE_MAX) {
+    switch (kernel) {
+#ifdef DBSYS_X86
+        case MatchKernel::AVX2: mask_fn = maskAVX2; break;
+        case MatchKernel::SSE2: mask_fn = maskSSE2; break;
+#endif
+        default:
+            kernel = MatchKernel::SCALAR;
+            mask_fn = maskScalar;
+            break;
+    }
+}
+
+bool TBLParser::encodeLine(const char* data, size_t begin, size_t end, Output& out) {
+    size_t columns = schema->getColumnCount();
+    if (field_ends.size() + 1 < columns) {
+        return false;
+    }
+
+    // 필드 i는 [앞 '|' 다음, i번째 '|') (마지막 필드에 '|'가 없으면 줄 끝까지)
+    auto fieldBegin = [&](size_t i) { return i == 0 ? begin : field_ends[i - 1] + 1; };
+    auto fieldEnd = [&](size_t i) { return i < field_ends.size() ? field_ends[i] : end; };
+
+    size_t header_size = schema->getHeaderSize();
+    size_t total = header_size;
+    for (size_t i = 0; i < columns; ++i) {
+        if (schema->getColumn(i).type == FieldType::STRING) {
+            total += fieldEnd(i) - fieldBegin(i);
+        }
+    }
+    if (total > UINT16_MAX) {
+        return false;
+    }
+
+    size_t start = out.encoded.size();
+    out.encoded.resize(start + total);
+    char* rec = &out.encoded[start];
+    char* offsets = rec + schema->getFixedSize();
+    size_t string_pos = header_size;
+
+    for (size_t i = 0; i < columns; ++i) {
+        const Column& col = schema->getColumn(i);
+        const char* field = data + fieldBegin(i);
+        const char* field_end = data + fieldEnd(i);
+
+        if (col.type == FieldType::INT) {
+            // 기존 파서와 같이 "Supplier#" 접두사 뒤의 숫자만 사용
+            static const char SUPPLIER_PREFIX[] = "Supplier#";
+            const size_t prefix_len = sizeof(SUPPLIER_PREFIX) - 1;
+            if (i == supplier_key_col && static_cast<size_t>(field_end - field) > prefix_len &&
+                std::memcmp(field, SUPPLIER_PREFIX, prefix_len) == 0) {
+                field += prefix_len;
+            }
+
+            int_t v;
+            if (!parseInt(field, field_end, v)) {
+                out.encoded.resize(start);
+                return false;
+            }
+            storeLE32(rec + col.position, static_cast<uint32_t>(v));
+        } else if (col.type == FieldType::DECIMAL) {
+            decimal_t v;
+            if (!parseDecimal(field, field_end, v)) {
+                out.encoded.resize(start);
+                return false;
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            storeLE32(rec + col.position, bits);
+        } else {
+            size_t len = static_cast<size_t>(field_end - field);
+            std::memcpy(rec + string_pos, field, len);
+            string_pos += len;
+            storeLE16(offsets + col.position * sizeof(uint16_t), static_cast<uint16_t>(string_pos));
+        }
+    }
+
+    out.sizes.push_back(static_cast<uint32_t>(total));
+    out.line_offsets.push_back(static_cast<uint32_t>(begin));
+    return true;
+}
+
+void TBLParser::parseLegacy(const char* data, size_t begin, size_t end, Output& out) {
+    std::string line(data + begin, data + end);
+    try {
+        Record record = legacy(line);
+        const std::vector<char>& bytes = record.serialize();
+        out.encoded.insert(out.encoded.end(), bytes.begin(), bytes.end());
+        out.sizes.push_back(static_cast<uint32_t>(bytes.size()));
+        out.line_offsets.push_back(static_cast<uint32_t>(begin));
+    } catch (const std::exception& e) {
+        out.errors.push_back("Error parsing line: " + line + "\nError: " + e.what());
+    }
+}
+
+void TBLParser::parseChunk(const char* data, size_t size, Output& out) {
+    char tail[64];
+    size_t base = 0;
+    uint64_t mask = 0;
+    size_t line_begin = 0;
+    field_ends.clear();
+
+    // 64바이트 단위 마스크 (마지막 자투리는 0으로 채운 복사본에서 계산)
+    auto loadMask = [&](size_t offset) -> uint64_t {
+        if (offset + 64 <= size) {
+            return mask_fn(data + offset);
+        }
+        std::memset(tail, 0, sizeof(tail));
+        std::memcpy(tail, data + offset, size - offset);
+        return mask_fn(tail);
+    };
+
+    if (size > 0) {
+        mask = loadMask(0);
+    }
+
+    while (true) {
+        // 다음 구분자 위치 (없으면 size)
+        while (mask == 0) {
+            base += 64;
+            if (base >= size) break;
+            mask = loadMask(base);
+        }
+        size_t pos = mask ? base + __builtin_ctzll(mask) : size;
+        mask &= mask - 1;
+
+        if (pos < size && data[pos] == '|') {
+            field_ends.push_back(pos);
+            continue;
+        }
+
+        // 줄 끝 ('\n' 또는 입력 끝)
+        if (pos > line_begin) {
+            if (!fast_path) {
+                parseLegacy(data, line_begin, pos, out);
+            } else if (!encodeLine(data, line_begin, pos, out)) {
+                fallback_lines++;
+                parseLegacy(data, line_begin, pos, out);
+            }
+        }
+        field_ends.clear();
+
+        if (pos >= size) break;
+        line_begin = pos + 1;
+    }
+}
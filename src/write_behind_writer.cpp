@@ -0,0 +1,243 @@
+#include "write_behind_writer.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+const size_t WriteBehindWriter::DEFAULT_POOL_BLOCKS;
+const size_t WriteBehindWriter::MAX_BATCH;
+
+WriteBehindWriter::WriteBehindWriter(const std::string& fname, size_t blk_size,
+                                     size_t pool_blocks, Statistics* st)
+    : filename(fname), fd(-1), block_size(blk_size), stats(st), closing(false), error_reported(false),
+      write_calls(0), blocks_written(0), stall_time(0.0) {
+
+    if (pool_blocks == 0) {
+        throw std::runtime_error("Write-behind pool must have at least 1 block");
+    }
+
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+
+    for (size_t i = 0; i < pool_blocks; ++i) {
+        pool.emplace_back(block_size);
+        free_blocks.push_back(i);
+    }
+
+    flush_thread = std::thread(&WriteBehindWriter::flushLoop, this);
+}
+
+WriteBehindWriter::~WriteBehindWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+}
+
+// ============================================================================
+// 플러시 스레드
+// ============================================================================
+
+void WriteBehindWriter::flushLoop() {
+    off_t offset = 0;
+    std::vector<size_t> batch;
+    std::vector<struct iovec> iov;
+
+    while (true) {
+        // 대기열에서 최대 MAX_BATCH개 블록 꺼내기
+        bool discard;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [this]() { return !queued.empty() || closing; });
+            if (queued.empty()) {
+                return;
+            }
+            batch.clear();
+            while (!queued.empty() && batch.size() < MAX_BATCH) {
+                batch.push_back(queued.front());
+                queued.pop_front();
+            }
+            // 한 번 실패하면 파일 끝이 어긋나므로 이후 블록은 기록하지 않고 버림
+            discard = static_cast<bool>(error);
+        }
+
+        if (discard) {
+            for (size_t b : batch) {
+                pool[b].clear();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                free_blocks.insert(free_blocks.end(), batch.begin(), batch.end());
+            }
+            block_freed.notify_all();
+            continue;
+        }
+
+        // 잠금 없이 연속된 블록들을 한 번의 pwritev로 기록
+        // (빈 공간을 0으로 채우는 memset도 조인 스레드 밖에서 수행)
+        iov.resize(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            pool[batch[i]].zeroFreeSpace();
+            iov[i].iov_base = pool[batch[i]].getData();
+            iov[i].iov_len = block_size;
+        }
+
+        size_t total = batch.size() * block_size;
+        size_t done = 0;
+        size_t first = 0;
+        std::string failure;   // 비어 있지 않으면 기록 실패 사유
+        while (done < total) {
+            ssize_t n = pwritev(fd, iov.data() + first, static_cast<int>(iov.size() - first),
+                                offset + static_cast<off_t>(done));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                failure = std::strerror(errno);
+                break;
+            }
+            if (n == 0) {
+                // errno가 설정되지 않으므로 strerror를 쓰지 않음
+                failure = "short write (" + std::to_string(done) + " of " +
+                          std::to_string(total) + " bytes)";
+                break;
+            }
+            done += static_cast<size_t>(n);
+
+            // 부분 기록: 다 쓴 iovec을 건너뛰고 나머지 위치 조정
+            size_t skip = static_cast<size_t>(n);
+            while (first < iov.size() && skip >= iov[first].iov_len) {
+                skip -= iov[first].iov_len;
+                first++;
+            }
+            if (first < iov.size()) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + skip;
+                iov[first].iov_len -= skip;
+            }
+        }
+        if (failure.empty()) {
+            offset += static_cast<off_t>(total);
+        }
+
+        // 기록한 블록을 비워 풀로 반환
+        for (size_t b : batch) {
+            pool[b].clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failure.empty()) {
+                error = std::make_exception_ptr(
+                    std::runtime_error("Write error on " + filename + ": " + failure));
+            } else {
+                blocks_written += batch.size();
+            }
+            write_calls++;
+            free_blocks.insert(free_blocks.end(), batch.begin(), batch.end());
+        }
+        block_freed.notify_all();
+    }
+}
+
+// ============================================================================
+// 조인 스레드 인터페이스
+// ============================================================================
+
+size_t WriteBehindWriter::takeFreeBlock(std::unique_lock<std::mutex>& lock) {
+    if (error) {
+        error_reported = true;
+        std::rethrow_exception(error);
+    }
+    if (closing) {
+        throw std::runtime_error("Write to closed writer: " + filename);
+    }
+
+    // 풀이 모두 기록 대기 중이면 플러시 스레드가 하나 돌려줄 때까지 대기
+    if (free_blocks.empty()) {
+        auto start = std::chrono::high_resolution_clock::now();
+        block_freed.wait(lock, [this]() { return !free_blocks.empty() || error; });
+        std::chrono::duration<double> waited = std::chrono::high_resolution_clock::now() - start;
+        stall_time += waited.count();
+        if (error) {
+            error_reported = true;
+            std::rethrow_exception(error);
+        }
+    }
+
+    size_t index = free_blocks.back();
+    free_blocks.pop_back();
+    return index;
+}
+
+bool WriteBehindWriter::writeBlock(const Block* block) {
+    if (block->isEmpty()) {
+        return false;
+    }
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while writing " + filename);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t index = takeFreeBlock(lock);
+        std::memcpy(pool[index].getData(), block->getData(), block_size);
+        queued.push_back(index);
+    }
+    work_ready.notify_one();
+
+    if (stats) {
+        stats->block_writes++;
+    }
+    return true;
+}
+
+void WriteBehindWriter::flushBlock(Block* block) {
+    if (block->isEmpty()) {
+        return;
+    }
+    if (block->getSize() != block_size) {
+        throw std::runtime_error("Block size mismatch while writing " + filename);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t index = takeFreeBlock(lock);
+
+        // 가득 찬 블록은 풀로, 비어 있던 풀 블록은 호출자에게
+        std::swap(*block, pool[index]);
+        queued.push_back(index);
+    }
+    work_ready.notify_one();
+
+    if (stats) {
+        stats->block_writes++;
+    }
+}
+
+void WriteBehindWriter::close() {
+    if (flush_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        work_ready.notify_one();
+        flush_thread.join();
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+
+    // 이미 flushBlock()에서 던진 오류는 다시 보고하지 않음
+    if (error && !error_reported) {
+        error_reported = true;
+        std::rethrow_exception(error);
+    }
+}